@@ -0,0 +1,458 @@
+﻿/**************************************************
+ * @brief   : 有序序列的归并：merge, inplace_merge, 多路归并与并行归并
+ * @file    : sx_algorithm.h
+ * @author  : 宋旭
+ * @date    : 2026年10月19日，00:18:42
+ **************************************************/
+
+#ifndef _SX_ALGORITHM_H_
+#define _SX_ALGORITHM_H_
+#include <exception>		// exception_ptr, rethrow_exception
+#include <functional>		// less
+#include <new>				// operator new, nothrow, align_val_t
+#include <thread>			// thread, hardware_concurrency
+#include <type_traits>		// remove_cvref_t
+#include <utility>			// move, swap
+#include <vector>			// vector
+#include "sx_iterator.h"
+#include "sx_trace.h"
+
+SX_NAMESPACE_BEGIN
+
+/**
+ * 以下算法都是稳定的：相等的元素中，来自前面的序列(或前面的 run)的先输出
+ *
+ * merge			-- 将两个有序区间归并到 result
+ * inplace_merge	-- 将相邻的有序区间 [first, middle) 与 [middle, last) 原地归并，
+ *					   能申请到较短一半大小的缓冲区时为线性时间，否则退化为 O(n log n) 的旋转归并
+ * merge_runs		-- 多路归并，[first_run, last_run) 中每个元素是一对迭代器(.first, .second)表示一个有序 run，
+ *					   使用败者树，每输出一个元素只需约 log2(k) 次比较，且所有 run 只遍历一遍
+ * parallel_merge	-- 以 co-ranking 将输出按位置均分给多个线程，每个线程二分查找出自己在两个输入中的起点后独立归并，
+ *					   要求随机访问迭代器
+ */
+template<class InputIterator1, class InputIterator2, class OutputIterator, class Compare>
+OutputIterator merge(InputIterator1 first1, InputIterator1 last1,
+	InputIterator2 first2, InputIterator2 last2, OutputIterator result, Compare comp)
+{
+	while (first1 != last1 && first2 != last2)
+	{
+		if (comp(*first2, *first1))
+		{
+			*result = *first2;
+			++first2;
+		}
+		else
+		{
+			*result = *first1;
+			++first1;
+		}
+		++result;
+	}
+	for (; first1 != last1; ++first1, ++result) *result = *first1;
+	for (; first2 != last2; ++first2, ++result) *result = *first2;
+	return result;
+}
+
+template<class InputIterator1, class InputIterator2, class OutputIterator>
+OutputIterator merge(InputIterator1 first1, InputIterator1 last1,
+	InputIterator2 first2, InputIterator2 last2, OutputIterator result)
+{
+	return sx::merge(first1, last1, first2, last2, result, std::less<>());
+}
+
+
+/**
+ * inplace_merge
+ */
+namespace detail {
+	template<class BidirectionalIterator>
+	void __reverse(BidirectionalIterator first, BidirectionalIterator last)
+	{
+		while (first != last && first != --last)
+		{
+			using std::swap;
+			swap(*first, *last);
+			++first;
+		}
+	}
+
+	// 返回原来的 first 移动后的位置
+	template<class BidirectionalIterator>
+	BidirectionalIterator __rotate(BidirectionalIterator first, BidirectionalIterator middle, BidirectionalIterator last)
+	{
+		if (first == middle) return last;
+		if (middle == last) return first;
+		auto n = sx::distance(middle, last);
+		detail::__reverse(first, middle);
+		detail::__reverse(middle, last);
+		detail::__reverse(first, last);
+		sx::advance(first, n);
+		return first;
+	}
+
+	template<class ForwardIterator, class T, class Compare>
+	ForwardIterator __lower_bound(ForwardIterator first, ForwardIterator last, const T& value, Compare& comp)
+	{
+		auto len = sx::distance(first, last);
+		while (len > 0)
+		{
+			auto half = len / 2;
+			ForwardIterator mid = first;
+			sx::advance(mid, half);
+			if (comp(*mid, value))
+			{
+				first = ++mid;
+				len -= half + 1;
+			}
+			else len = half;
+		}
+		return first;
+	}
+
+	template<class ForwardIterator, class T, class Compare>
+	ForwardIterator __upper_bound(ForwardIterator first, ForwardIterator last, const T& value, Compare& comp)
+	{
+		auto len = sx::distance(first, last);
+		while (len > 0)
+		{
+			auto half = len / 2;
+			ForwardIterator mid = first;
+			sx::advance(mid, half);
+			if (!comp(value, *mid))
+			{
+				first = ++mid;
+				len -= half + 1;
+			}
+			else len = half;
+		}
+		return first;
+	}
+
+	// 未初始化的临时缓冲区，申请失败时 data() 为 nullptr
+	template<class T>
+	class __temporary_buffer
+	{
+	private:
+		T*		buf			= nullptr;
+		size_t	constructed	= 0;
+
+	public:
+		explicit __temporary_buffer(size_t n)noexcept
+		{
+			if (n <= SIZE_MAX / sizeof(T))
+				buf = static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(alignof(T)), std::nothrow));
+		}
+
+		__temporary_buffer(const __temporary_buffer&) = delete;
+		__temporary_buffer& operator=(const __temporary_buffer&) = delete;
+
+		~__temporary_buffer()
+		{
+			for (size_t i = 0; i < constructed; ++i) buf[i].~T();
+			::operator delete(static_cast<void*>(buf), std::align_val_t(alignof(T)));
+		}
+
+		T* data()const noexcept { return buf; }
+
+		// 将 [first, last) 移动构造到缓冲区开头，返回末尾
+		template<class InputIterator>
+		T* move_in(InputIterator first, InputIterator last)
+		{
+			T* p = buf;
+			for (; first != last; ++first, ++p, ++constructed) ::new (static_cast<void*>(p)) T(std::move(*first));
+			return p;
+		}
+	};
+
+	template<class BidirectionalIterator, class Distance, class Compare>
+	void __merge_without_buffer(BidirectionalIterator first, BidirectionalIterator middle, BidirectionalIterator last,
+		Distance len1, Distance len2, Compare& comp)
+	{
+		if (len1 == 0 || len2 == 0) return;
+		if (len1 + len2 == 2)
+		{
+			if (comp(*middle, *first))
+			{
+				using std::swap;
+				swap(*first, *middle);
+			}
+			return;
+		}
+
+		BidirectionalIterator first_cut = first;
+		BidirectionalIterator second_cut = middle;
+		Distance len11 = 0;
+		Distance len22 = 0;
+		if (len1 > len2)
+		{
+			len11 = len1 / 2;
+			sx::advance(first_cut, len11);
+			second_cut = detail::__lower_bound(middle, last, *first_cut, comp);
+			len22 = sx::distance(middle, second_cut);
+		}
+		else
+		{
+			len22 = len2 / 2;
+			sx::advance(second_cut, len22);
+			first_cut = detail::__upper_bound(first, middle, *second_cut, comp);
+			len11 = sx::distance(first, first_cut);
+		}
+
+		BidirectionalIterator new_middle = detail::__rotate(first_cut, middle, second_cut);
+		detail::__merge_without_buffer(first, first_cut, new_middle, len11, len22, comp);
+		detail::__merge_without_buffer(new_middle, second_cut, last, len1 - len11, len2 - len22, comp);
+	}
+
+	// 较短的一半移入缓冲区：前一半较短时从前往后归并，否则从后往前归并，写入位置不会越过未读的元素
+	template<class BidirectionalIterator, class Distance, class T, class Compare>
+	void __merge_with_buffer(BidirectionalIterator first, BidirectionalIterator middle, BidirectionalIterator last,
+		Distance len1, Distance len2, __temporary_buffer<T>& buffer, Compare& comp)
+	{
+		if (len1 <= len2)
+		{
+			T* b = buffer.data();
+			T* bend = buffer.move_in(first, middle);
+			while (b != bend && middle != last)
+			{
+				if (comp(*middle, *b))
+				{
+					*first = std::move(*middle);
+					++middle;
+				}
+				else
+				{
+					*first = std::move(*b);
+					++b;
+				}
+				++first;
+			}
+			for (; b != bend; ++b, ++first) *first = std::move(*b);
+		}
+		else
+		{
+			T* b = buffer.data();
+			T* bend = buffer.move_in(middle, last);
+			while (b != bend && first != middle)
+			{
+				BidirectionalIterator prev = middle;
+				--prev;
+				if (comp(*(bend - 1), *prev))
+				{
+					*--last = std::move(*prev);
+					middle = prev;
+				}
+				else *--last = std::move(*--bend);
+			}
+			while (b != bend) *--last = std::move(*--bend);
+		}
+	}
+}
+
+template<class BidirectionalIterator, class Compare>
+void inplace_merge(BidirectionalIterator first, BidirectionalIterator middle, BidirectionalIterator last, Compare comp)
+{
+	using value_type = typename iterator_traits<BidirectionalIterator>::value_type;
+
+	if (first == middle || middle == last) return;
+	auto len1 = sx::distance(first, middle);
+	auto len2 = sx::distance(middle, last);
+
+	detail::__temporary_buffer<value_type> buffer(static_cast<size_t>(len1 < len2 ? len1 : len2));
+	if (buffer.data() != nullptr)
+		detail::__merge_with_buffer(first, middle, last, len1, len2, buffer, comp);
+	else
+		detail::__merge_without_buffer(first, middle, last, len1, len2, comp);
+}
+
+template<class BidirectionalIterator>
+void inplace_merge(BidirectionalIterator first, BidirectionalIterator middle, BidirectionalIterator last)
+{
+	sx::inplace_merge(first, middle, last, std::less<>());
+}
+
+
+/**
+ * merge_runs
+ * 败者树：tree[p] 保存在内部结点 p 处比赛失败的 run，tree[0] 保存总的胜者
+ * run i 对应的叶子为 k + i，父结点为 p / 2，对任意的 k 都成立
+ * 取出胜者的一个元素后，只需沿其叶子到根的路径与各结点的败者重新比较
+ */
+namespace detail {
+	template<class InputIterator, class Compare>
+	class __loser_tree
+	{
+	private:
+		std::vector<InputIterator>	cur;
+		std::vector<InputIterator>	end;
+		std::vector<size_t>			tree;
+		Compare&					comp;
+
+		// run a 是否排在 run b 之前；用完的 run 视为无穷大，相等时下标小的在前
+		bool __beats(size_t a, size_t b)
+		{
+			if (cur[a] == end[a]) return false;
+			if (cur[b] == end[b]) return true;
+			return a < b ? !comp(*cur[b], *cur[a]) : static_cast<bool>(comp(*cur[a], *cur[b]));
+		}
+
+	public:
+		template<class RunIterator>
+		__loser_tree(RunIterator first_run, RunIterator last_run, Compare& c) : comp(c)
+		{
+			for (; first_run != last_run; ++first_run)
+			{
+				cur.push_back((*first_run).first);
+				end.push_back((*first_run).second);
+			}
+
+			const size_t k = cur.size();
+			if (k == 0) return;
+			tree.assign(k, 0);
+			std::vector<size_t> winner(2 * k);
+			for (size_t i = 0; i < k; ++i) winner[k + i] = i;
+			for (size_t p = k - 1; p >= 1; --p)
+			{
+				size_t a = winner[2 * p];
+				size_t b = winner[2 * p + 1];
+				if (__beats(b, a)) std::swap(a, b);
+				winner[p] = a;
+				tree[p] = b;
+			}
+			tree[0] = winner[1];
+		}
+
+		template<class OutputIterator>
+		OutputIterator run(OutputIterator result)
+		{
+			const size_t k = cur.size();
+			if (k == 0) return result;
+			for (;;)
+			{
+				size_t w = tree[0];
+				if (cur[w] == end[w]) return result;
+				*result = *cur[w];
+				++result;
+				++cur[w];
+
+				for (size_t p = (w + k) / 2; p >= 1; p /= 2)
+				{
+					if (__beats(tree[p], w)) std::swap(tree[p], w);
+				}
+				tree[0] = w;
+			}
+		}
+	};
+}
+
+template<class RunIterator, class OutputIterator, class Compare>
+OutputIterator merge_runs(RunIterator first_run, RunIterator last_run, OutputIterator result, Compare comp)
+{
+	SX_SCOPED_TIMER("merge_runs");
+	using input_iterator = std::remove_cvref_t<decltype((*first_run).first)>;
+	detail::__loser_tree<input_iterator, Compare> tree(first_run, last_run, comp);
+	return tree.run(result);
+}
+
+template<class RunIterator, class OutputIterator>
+OutputIterator merge_runs(RunIterator first_run, RunIterator last_run, OutputIterator result)
+{
+	return sx::merge_runs(first_run, last_run, result, std::less<>());
+}
+
+
+/**
+ * parallel_merge
+ * threads 为 0 时使用 hardware_concurrency，每个线程至少分到 __parallel_merge_grain 个元素，
+ * 调用线程自己处理最后一段；比较函数抛出的异常在所有线程结束后重新抛出
+ */
+namespace detail {
+	constexpr size_t __parallel_merge_grain = 16 * 1024;
+
+	// 输出的前 k 个元素中来自第一个序列的个数
+	template<class RandomIterator1, class RandomIterator2, class Distance, class Compare>
+	Distance __co_rank(Distance k, RandomIterator1 first1, Distance n1, RandomIterator2 first2, Distance n2, Compare& comp)
+	{
+		Distance lo = k > n2 ? k - n2 : 0;
+		Distance hi = k < n1 ? k : n1;
+		while (lo < hi)
+		{
+			Distance i = lo + (hi - lo) / 2;
+			Distance j = k - i;
+			if (!comp(first2[j - 1], first1[i])) lo = i + 1;
+			else hi = i;
+		}
+		return lo;
+	}
+
+	// 析构时等待所有已启动的线程，创建线程失败抛出异常时也不会析构仍可 join 的 std::thread
+	struct __join_guard
+	{
+		std::vector<std::thread>& threads;
+
+		~__join_guard()
+		{
+			for (std::thread& t : threads)
+			{
+				if (t.joinable()) t.join();
+			}
+		}
+	};
+}
+
+template<class RandomIterator1, class RandomIterator2, class RandomIterator3, class Compare>
+RandomIterator3 parallel_merge(RandomIterator1 first1, RandomIterator1 last1,
+	RandomIterator2 first2, RandomIterator2 last2, RandomIterator3 result, Compare comp, size_t threads = 0)
+{
+	SX_SCOPED_TIMER("parallel_merge");
+	using distance_type = ptrdiff_t;
+
+	const distance_type n1 = last1 - first1;
+	const distance_type n2 = last2 - first2;
+	const size_t total = static_cast<size_t>(n1 + n2);
+
+	if (threads == 0) threads = std::thread::hardware_concurrency();
+	const size_t max_threads = total / detail::__parallel_merge_grain;
+	if (threads > max_threads) threads = max_threads;
+	if (threads <= 1) return sx::merge(first1, last1, first2, last2, result, comp);
+
+	std::vector<std::exception_ptr> errors(threads);
+	auto work = [&](size_t t)
+	{
+		try
+		{
+			const distance_type begin = static_cast<distance_type>(total * t / threads);
+			const distance_type end = static_cast<distance_type>(total * (t + 1) / threads);
+			const distance_type i0 = detail::__co_rank(begin, first1, n1, first2, n2, comp);
+			const distance_type i1 = detail::__co_rank(end, first1, n1, first2, n2, comp);
+			sx::merge(first1 + i0, first1 + i1, first2 + (begin - i0), first2 + (end - i1), result + begin, comp);
+		}
+		catch (...)
+		{
+			errors[t] = std::current_exception();
+		}
+	};
+
+	std::vector<std::thread> workers;
+	workers.reserve(threads - 1);
+	{
+		detail::__join_guard join{ workers };
+		for (size_t t = 0; t + 1 < threads; ++t) workers.emplace_back(work, t);
+		work(threads - 1);
+	}
+
+	for (const std::exception_ptr& e : errors)
+	{
+		if (e) std::rethrow_exception(e);
+	}
+	return result + static_cast<distance_type>(total);
+}
+
+template<class RandomIterator1, class RandomIterator2, class RandomIterator3>
+RandomIterator3 parallel_merge(RandomIterator1 first1, RandomIterator1 last1,
+	RandomIterator2 first2, RandomIterator2 last2, RandomIterator3 result)
+{
+	return sx::parallel_merge(first1, last1, first2, last2, result, std::less<>());
+}
+
+SX_NAMESPACE_END
+#endif	// end define _SX_ALGORITHM_H_
@@ -0,0 +1,165 @@
+﻿/**************************************************
+ * @brief   : 线程安全的单调(bump)内存池
+ * @file    : sx_arena.h
+ * @author  : 宋旭
+ * @date    : 2026年10月18日，22:41:19
+ **************************************************/
+
+#ifndef _SX_ARENA_H_
+#define _SX_ARENA_H_
+#include <atomic>			// atomic
+#include <cstddef>			// max_align_t
+#include <cstdint>			// uintptr_t
+#include <new>				// operator new, bad_alloc
+#include <utility>			// forward, declval
+#include "sx_def.h"
+
+SX_NAMESPACE_BEGIN
+
+/**
+ * arena
+ * 从大块内存中顺序切分，分配只是对当前块的偏移量做一次 CAS，不能单独释放，
+ * 所有内存在 arena 析构时一次性归还
+ * 当前块用尽时申请新块并以 CAS 替换当前块，不加锁；同时换块的线程中只有一个成功，
+ * 其余线程归还自己申请的块后从新的当前块分配。申请块本身由 Backend 完成，是否加锁取决于 Backend
+ * 适合只增不删，或与整个容器同生命周期的节点(例如并发跳表的节点)
+ *
+ * create<T>() 构造的对象不会被 arena 析构，需要时由使用者自行调用析构函数
+ *
+ * 块的内存来自 Backend，需提供 allocate(bytes) 与 deallocate(p, bytes)，默认使用全局 operator new；
+ * Backend 还提供 mapped_size(bytes)(实际占用的字节数)时，块扩大到占满实际分配的内存，
+ * 例如以使用大页的 page_allocator 为 Backend 时，64KB 的块会扩大为约 2MB，而不是映射 2MB 只用 64KB
+ */
+namespace detail {
+	struct alignas(std::max_align_t) __arena_block
+	{
+		__arena_block*		next;
+		size_t				size;	// data 区域的字节数
+		std::atomic<size_t>	used;
+
+		char* data()noexcept { return reinterpret_cast<char*>(this + 1); }
+	};
+
+	inline char* __align_up(char* p, size_t align)noexcept
+	{
+		uintptr_t v = reinterpret_cast<uintptr_t>(p);
+		return reinterpret_cast<char*>((v + align - 1) & ~(uintptr_t(align) - 1));
+	}
+
+	// Backend 是否提供 mapped_size(bytes)
+	template<class Backend>
+	struct __has_mapped_size
+	{
+		template<class U> static int test(...);
+		template<class U> static char test(decltype(std::declval<const U&>().mapped_size(size_t()))*);
+		static constexpr bool value = sizeof(test<Backend>(nullptr)) == sizeof(char);
+	};
+
+	struct __new_backend
+	{
+		void* allocate(size_t bytes) { return ::operator new(bytes); }
+		void deallocate(void* p, size_t bytes)noexcept { ::operator delete(p, bytes); }
+	};
+}
+
+template<class Backend = detail::__new_backend>
+class basic_arena
+{
+public:
+	using backend_type = Backend;
+
+	static constexpr size_t default_block_size = 64 * 1024;
+
+private:
+	std::atomic<detail::__arena_block*>	current{ nullptr };	// 所有块经 next 组成链表，当前块为表头
+	size_t								block_size;
+	std::atomic<size_t>					reserved{ 0 };		// 已申请的块的总字节数
+	Backend								backend;
+
+public:
+	explicit basic_arena(size_t block_bytes = default_block_size, const Backend& b = Backend())
+		: block_size(block_bytes), backend(b) {}
+
+	basic_arena(const basic_arena&) = delete;
+	basic_arena& operator=(const basic_arena&) = delete;
+
+	~basic_arena()
+	{
+		detail::__arena_block* b = current.load(std::memory_order_acquire);
+		while (b != nullptr)
+		{
+			detail::__arena_block* next = b->next;
+			const size_t bytes = sizeof(detail::__arena_block) + b->size;
+			b->~__arena_block();
+			backend.deallocate(static_cast<void*>(b), bytes);
+			b = next;
+		}
+	}
+
+	// align 必须是 2 的幂
+	void* allocate(size_t n, size_t align = alignof(std::max_align_t))
+	{
+		for (;;)
+		{
+			detail::__arena_block* b = current.load(std::memory_order_acquire);
+			if (b != nullptr)
+			{
+				size_t used = b->used.load(std::memory_order_relaxed);
+				for (;;)
+				{
+					char* start = detail::__align_up(b->data() + used, align);
+					size_t end = static_cast<size_t>(start - b->data()) + n;
+					if (end > b->size) break;
+					if (b->used.compare_exchange_weak(used, end, std::memory_order_relaxed))
+						return start;
+				}
+			}
+			if (void* p = __allocate_slow(b, n, align)) return p;
+		}
+	}
+
+	template<class T, class... Args>
+	T* create(Args&&... args)
+	{
+		return ::new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+	}
+
+	// 已向系统申请的字节数
+	size_t bytes_reserved()const noexcept { return reserved.load(std::memory_order_relaxed); }
+
+private:
+	/**
+	 * 申请新块并在其中完成本次分配，再以 CAS 将当前块由 seen 换为新块
+	 * 新块的 next 指向 seen，因此换块成功后链表仍包含所有块
+	 * CAS 失败说明其他线程已换块，归还新块并返回 nullptr 重试
+	 */
+	void* __allocate_slow(detail::__arena_block* seen, size_t n, size_t align)
+	{
+		size_t need = n + (align > alignof(std::max_align_t) ? align : 0);
+		size_t size = need > block_size ? need : block_size;
+		size_t bytes = sizeof(detail::__arena_block) + size;
+		if constexpr (detail::__has_mapped_size<Backend>::value)
+		{
+			bytes = backend.mapped_size(bytes);
+			size = bytes - sizeof(detail::__arena_block);
+		}
+		void* raw = backend.allocate(bytes);
+		detail::__arena_block* b = ::new (raw) detail::__arena_block{ seen, size, {} };
+
+		char* start = detail::__align_up(b->data(), align);
+		b->used.store(static_cast<size_t>(start - b->data()) + n, std::memory_order_relaxed);
+		if (!current.compare_exchange_strong(seen, b, std::memory_order_release, std::memory_order_acquire))
+		{
+			b->~__arena_block();
+			backend.deallocate(raw, bytes);
+			return nullptr;
+		}
+		reserved.fetch_add(bytes, std::memory_order_relaxed);
+		return start;
+	}
+};
+
+using arena = basic_arena<>;
+
+SX_NAMESPACE_END
+#endif	// end define _SX_ARENA_H_
@@ -0,0 +1,68 @@
+﻿/**************************************************
+ * @brief   : 位操作相关的函数
+ * @file    : sx_bit.h
+ * @author  : 宋旭
+ * @date    : 2026年10月18日，17:05:36
+ **************************************************/
+
+#ifndef _SX_BIT_H_
+#define _SX_BIT_H_
+#include <cstdint>			// uint64_t
+#include "sx_def.h"
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>			// __popcnt64, _BitScanForward64, _BitScanReverse64
+#endif // _MSC_VER
+
+SX_NAMESPACE_BEGIN
+
+/**
+ * 对 64 位无符号整数的位操作，尽量使用硬件指令
+ * 编译时开启 -mpopcnt / -mbmi (或 -march=native) 后分别生成 popcnt / tzcnt / lzcnt
+ *
+ * popcount		-- 置位的个数
+ * countr_zero	-- 末尾 0 的个数，x 为 0 时返回 64
+ * countl_zero	-- 开头 0 的个数，x 为 0 时返回 64
+ * bit_width	-- 表示 x 所需的最少位数，x 为 0 时返回 0
+ */
+
+inline int popcount(uint64_t x)noexcept
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+	return static_cast<int>(__popcnt64(x));
+#else
+	return __builtin_popcountll(x);
+#endif // _MSC_VER
+}
+
+inline int countr_zero(uint64_t x)noexcept
+{
+	if (x == 0) return 64;
+#if defined(_MSC_VER) && !defined(__clang__)
+	unsigned long index;
+	_BitScanForward64(&index, x);
+	return static_cast<int>(index);
+#else
+	return __builtin_ctzll(x);
+#endif // _MSC_VER
+}
+
+inline int countl_zero(uint64_t x)noexcept
+{
+	if (x == 0) return 64;
+#if defined(_MSC_VER) && !defined(__clang__)
+	unsigned long index;
+	_BitScanReverse64(&index, x);
+	return 63 - static_cast<int>(index);
+#else
+	return __builtin_clzll(x);
+#endif // _MSC_VER
+}
+
+inline int bit_width(uint64_t x)noexcept
+{
+	return 64 - countl_zero(x);
+}
+
+SX_NAMESPACE_END
+#endif	// end define _SX_BIT_H_
@@ -0,0 +1,567 @@
+﻿/**************************************************
+ * @brief   : bitset 与 dynamic_bitset
+ * @file    : sx_bitset.h
+ * @author  : 宋旭
+ * @date    : 2026年10月18日，17:12:08
+ **************************************************/
+
+#ifndef _SX_BITSET_H_
+#define _SX_BITSET_H_
+#include <cstdint>			// uint64_t
+#include <cstring>			// memset, memcmp
+#include <stdexcept>		// out_of_range, invalid_argument
+#include <vector>			// vector
+#include "sx_bit.h"
+#include "sx_iterator.h"
+#include "sx_trace.h"
+
+#ifdef __AVX2__
+#include <immintrin.h>		// AVX2
+#endif // __AVX2__
+
+SX_NAMESPACE_BEGIN
+
+namespace detail {
+	using __bit_word = uint64_t;
+	constexpr size_t __bits_per_word = 64;
+
+	constexpr size_t __bit_word_count(size_t bits)noexcept
+	{
+		return (bits + __bits_per_word - 1) / __bits_per_word;
+	}
+
+	/**
+	 * 按字进行的批量逻辑运算 dst = dst op src
+	 * 开启 AVX2 时每次处理 4 个字，剩余部分逐字处理
+	 */
+	struct __bit_and
+	{
+		static __bit_word apply(__bit_word a, __bit_word b)noexcept { return a & b; }
+#ifdef __AVX2__
+		static __m256i apply(__m256i a, __m256i b)noexcept { return _mm256_and_si256(a, b); }
+#endif // __AVX2__
+	};
+
+	struct __bit_or
+	{
+		static __bit_word apply(__bit_word a, __bit_word b)noexcept { return a | b; }
+#ifdef __AVX2__
+		static __m256i apply(__m256i a, __m256i b)noexcept { return _mm256_or_si256(a, b); }
+#endif // __AVX2__
+	};
+
+	struct __bit_xor
+	{
+		static __bit_word apply(__bit_word a, __bit_word b)noexcept { return a ^ b; }
+#ifdef __AVX2__
+		static __m256i apply(__m256i a, __m256i b)noexcept { return _mm256_xor_si256(a, b); }
+#endif // __AVX2__
+	};
+
+	// a & ~b
+	struct __bit_andnot
+	{
+		static __bit_word apply(__bit_word a, __bit_word b)noexcept { return a & ~b; }
+#ifdef __AVX2__
+		static __m256i apply(__m256i a, __m256i b)noexcept { return _mm256_andnot_si256(b, a); }
+#endif // __AVX2__
+	};
+
+	template<class Op>
+	inline void __bulk_apply(__bit_word* dst, const __bit_word* src, size_t n)noexcept
+	{
+		size_t i = 0;
+#ifdef __AVX2__
+		for (; i + 4 <= n; i += 4)
+		{
+			__m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+			__m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), Op::apply(a, b));
+		}
+#endif // __AVX2__
+		for (; i < n; ++i) dst[i] = Op::apply(dst[i], src[i]);
+	}
+
+	/**
+	 * 批量统计置位个数
+	 * 开启 AVX2 时使用 4 位查表法(vpshufb)，每次处理 256 位，再用 vpsadbw 累加
+	 * 否则逐字使用 popcount
+	 */
+	inline size_t __bulk_popcount(const __bit_word* p, size_t n)noexcept
+	{
+		size_t total = 0;
+		size_t i = 0;
+#ifdef __AVX2__
+		const __m256i lookup = _mm256_setr_epi8(
+			0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+			0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+		const __m256i low_mask = _mm256_set1_epi8(0x0f);
+		__m256i acc = _mm256_setzero_si256();
+		for (; i + 4 <= n; i += 4)
+		{
+			__m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+			__m256i lo = _mm256_and_si256(v, low_mask);
+			__m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+			__m256i cnt = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo), _mm256_shuffle_epi8(lookup, hi));
+			acc = _mm256_add_epi64(acc, _mm256_sad_epu8(cnt, _mm256_setzero_si256()));
+		}
+		total += static_cast<size_t>(_mm256_extract_epi64(acc, 0)) + static_cast<size_t>(_mm256_extract_epi64(acc, 1)) +
+			static_cast<size_t>(_mm256_extract_epi64(acc, 2)) + static_cast<size_t>(_mm256_extract_epi64(acc, 3));
+#endif // __AVX2__
+		for (; i < n; ++i) total += static_cast<size_t>(popcount(p[i]));
+		return total;
+	}
+
+	// 两段字中是否存在同时置位的位
+	inline bool __bulk_intersects(const __bit_word* a, const __bit_word* b, size_t n)noexcept
+	{
+		size_t i = 0;
+#ifdef __AVX2__
+		for (; i + 4 <= n; i += 4)
+		{
+			__m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+			__m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+			if (!_mm256_testz_si256(x, y)) return true;
+		}
+#endif // __AVX2__
+		for (; i < n; ++i)
+			if ((a[i] & b[i]) != 0) return true;
+		return false;
+	}
+
+	// 从第 pos 位开始(包含 pos)查找第一个置位，不存在时返回 nbits
+	inline size_t __find_next(const __bit_word* p, size_t nbits, size_t pos)noexcept
+	{
+		if (pos >= nbits) return nbits;
+		const size_t n = __bit_word_count(nbits);
+		size_t i = pos / __bits_per_word;
+		__bit_word w = p[i] & (~__bit_word(0) << (pos % __bits_per_word));
+		while (w == 0)
+		{
+			if (++i == n) return nbits;
+			w = p[i];
+		}
+		return i * __bits_per_word + static_cast<size_t>(countr_zero(w));
+	}
+}
+
+
+/**
+ * 遍历所有置位的前向迭代器，解引用得到位的下标
+ * 缓存当前字中剩余的置位，每前进一步只需一次 blsr 与 tzcnt
+ */
+class set_bit_iterator : public iterator<forward_iterator_tag, size_t, ptrdiff_t, const size_t*, size_t>
+{
+private:
+	const detail::__bit_word*	words	= nullptr;
+	size_t						index	= 0;	// 当前字的下标
+	size_t						count	= 0;	// 字的总个数
+	detail::__bit_word			current	= 0;	// 当前字中尚未访问的置位
+
+public:
+	using self = set_bit_iterator;
+
+	set_bit_iterator() = default;
+
+	set_bit_iterator(const detail::__bit_word* p, size_t nwords, size_t start)noexcept
+		: words(p), index(start), count(nwords)
+	{
+		if (index < count)
+		{
+			current = words[index];
+			__skip_empty();
+		}
+	}
+
+	size_t operator*()const noexcept
+	{
+		return index * detail::__bits_per_word + static_cast<size_t>(countr_zero(current));
+	}
+
+	self& operator++()noexcept
+	{
+		current &= current - 1;
+		__skip_empty();
+		return *this;
+	}
+
+	self operator++(int)noexcept
+	{
+		auto temp = *this;
+		++*this;
+		return temp;
+	}
+
+	bool operator==(const self& rhs)const noexcept
+	{
+		return index == rhs.index && current == rhs.current;
+	}
+
+	bool operator!=(const self& rhs)const noexcept
+	{
+		return !(*this == rhs);
+	}
+
+private:
+	void __skip_empty()noexcept
+	{
+		while (current == 0)
+		{
+			if (++index >= count)
+			{
+				index = count;
+				return;
+			}
+			current = words[index];
+		}
+	}
+};
+
+// 置位集合的区间，用于 range-for
+class set_bit_range
+{
+private:
+	const detail::__bit_word*	words;
+	size_t						count;
+
+public:
+	set_bit_range(const detail::__bit_word* p, size_t nwords)noexcept : words(p), count(nwords) {}
+
+	set_bit_iterator begin()const noexcept { return set_bit_iterator(words, count, 0); }
+	set_bit_iterator end()const noexcept { return set_bit_iterator(words, count, count); }
+};
+
+
+namespace detail {
+	/**
+	 * bitset 与 dynamic_bitset 的公共实现
+	 * Derived 需提供 __words(), __nwords(), size()
+	 * 约定：最后一个字中超出 size() 的位恒为 0
+	 */
+	template<class Derived>
+	class __bitset_base
+	{
+	public:
+		// 对单个位的引用代理
+		class reference
+		{
+		private:
+			__bit_word*	word;
+			__bit_word	mask;
+
+		public:
+			reference(__bit_word* w, size_t bit)noexcept : word(w), mask(__bit_word(1) << bit) {}
+
+			reference& operator=(bool value)noexcept
+			{
+				if (value) *word |= mask;
+				else *word &= ~mask;
+				return *this;
+			}
+
+			reference& operator=(const reference& rhs)noexcept
+			{
+				return *this = static_cast<bool>(rhs);
+			}
+
+			operator bool()const noexcept { return (*word & mask) != 0; }
+			bool operator~()const noexcept { return (*word & mask) == 0; }
+
+			reference& flip()noexcept
+			{
+				*word ^= mask;
+				return *this;
+			}
+		};
+
+	public:
+		bool operator[](size_t pos)const noexcept
+		{
+			return (__self().__words()[pos / __bits_per_word] >> (pos % __bits_per_word)) & 1;
+		}
+
+		reference operator[](size_t pos)noexcept
+		{
+			return reference(__self().__words() + pos / __bits_per_word, pos % __bits_per_word);
+		}
+
+		bool test(size_t pos)const
+		{
+			__check(pos, "bitset::test");
+			return (*this)[pos];
+		}
+
+		Derived& set()noexcept
+		{
+			std::memset(__self().__words(), 0xff, __self().__nwords() * sizeof(__bit_word));
+			__sanitize();
+			return __self();
+		}
+
+		Derived& set(size_t pos, bool value = true)
+		{
+			__check(pos, "bitset::set");
+			(*this)[pos] = value;
+			return __self();
+		}
+
+		Derived& reset()noexcept
+		{
+			std::memset(__self().__words(), 0, __self().__nwords() * sizeof(__bit_word));
+			return __self();
+		}
+
+		Derived& reset(size_t pos)
+		{
+			return set(pos, false);
+		}
+
+		Derived& flip()noexcept
+		{
+			__bit_word* p = __self().__words();
+			for (size_t i = 0, n = __self().__nwords(); i < n; ++i) p[i] = ~p[i];
+			__sanitize();
+			return __self();
+		}
+
+		Derived& flip(size_t pos)
+		{
+			__check(pos, "bitset::flip");
+			(*this)[pos].flip();
+			return __self();
+		}
+
+		// 置位个数
+		size_t count()const noexcept
+		{
+			return __bulk_popcount(__self().__words(), __self().__nwords());
+		}
+
+		bool any()const noexcept
+		{
+			return find_first() != __self().size();
+		}
+
+		bool none()const noexcept
+		{
+			return !any();
+		}
+
+		bool all()const noexcept
+		{
+			return count() == __self().size();
+		}
+
+		// 第一个置位的下标，不存在时返回 size()
+		size_t find_first()const noexcept
+		{
+			return __find_next(__self().__words(), __self().size(), 0);
+		}
+
+		// pos 之后(不含 pos)第一个置位的下标，不存在时返回 size()
+		size_t find_next(size_t pos)const noexcept
+		{
+			return __find_next(__self().__words(), __self().size(), pos + 1);
+		}
+
+		// 所有置位构成的区间
+		set_bit_range set_bits()const noexcept
+		{
+			return set_bit_range(__self().__words(), __self().__nwords());
+		}
+
+		// 批量逻辑运算，要求两者位数相同
+		Derived& operator&=(const Derived& rhs)
+		{
+			return __apply<__bit_and>(rhs);
+		}
+
+		Derived& operator|=(const Derived& rhs)
+		{
+			return __apply<__bit_or>(rhs);
+		}
+
+		Derived& operator^=(const Derived& rhs)
+		{
+			return __apply<__bit_xor>(rhs);
+		}
+
+		// *this = *this & ~rhs
+		Derived& andnot(const Derived& rhs)
+		{
+			return __apply<__bit_andnot>(rhs);
+		}
+
+		// 是否与 rhs 存在共同的置位，不产生临时对象
+		bool intersects(const Derived& rhs)const
+		{
+			__check_size(rhs);
+			return __bulk_intersects(__self().__words(), rhs.__words(), __self().__nwords());
+		}
+
+		Derived operator~()const
+		{
+			Derived temp = __self();
+			temp.flip();
+			return temp;
+		}
+
+		friend Derived operator&(const Derived& lhs, const Derived& rhs)
+		{
+			Derived temp = lhs;
+			temp &= rhs;
+			return temp;
+		}
+
+		friend Derived operator|(const Derived& lhs, const Derived& rhs)
+		{
+			Derived temp = lhs;
+			temp |= rhs;
+			return temp;
+		}
+
+		friend Derived operator^(const Derived& lhs, const Derived& rhs)
+		{
+			Derived temp = lhs;
+			temp ^= rhs;
+			return temp;
+		}
+
+		friend bool operator==(const Derived& lhs, const Derived& rhs)noexcept
+		{
+			return lhs.size() == rhs.size() &&
+				std::memcmp(lhs.__words(), rhs.__words(), lhs.__nwords() * sizeof(__bit_word)) == 0;
+		}
+
+		friend bool operator!=(const Derived& lhs, const Derived& rhs)noexcept
+		{
+			return !(lhs == rhs);
+		}
+
+	protected:
+		Derived& __self()noexcept { return static_cast<Derived&>(*this); }
+		const Derived& __self()const noexcept { return static_cast<const Derived&>(*this); }
+
+		// 清除最后一个字中超出 size() 的位
+		void __sanitize()noexcept
+		{
+			size_t tail = __self().size() % __bits_per_word;
+			if (tail != 0) __self().__words()[__self().__nwords() - 1] &= (__bit_word(1) << tail) - 1;
+		}
+
+		void __check(size_t pos, const char* what)const
+		{
+			if (pos >= __self().size()) throw std::out_of_range(what);
+		}
+
+		void __check_size(const Derived& rhs)const
+		{
+			if (__self().size() != rhs.size()) throw std::invalid_argument("bitset: size mismatch");
+		}
+
+		template<class Op>
+		Derived& __apply(const Derived& rhs)
+		{
+			__check_size(rhs);
+			__bulk_apply<Op>(__self().__words(), rhs.__words(), __self().__nwords());
+			return __self();
+		}
+	};
+}
+
+
+/**
+ * bitset
+ * 位数在编译期确定，以 64 位字存储
+ */
+template<size_t N>
+class bitset : public detail::__bitset_base<bitset<N>>
+{
+	friend class detail::__bitset_base<bitset<N>>;
+
+private:
+	static constexpr size_t word_count = N == 0 ? 1 : detail::__bit_word_count(N);
+	detail::__bit_word words[word_count] = {};
+
+public:
+	using self = bitset<N>;
+
+	bitset() = default;
+
+	// 以整数的低位初始化
+	bitset(unsigned long long value)noexcept
+	{
+		words[0] = value;
+		this->__sanitize();
+	}
+
+	constexpr size_t size()const noexcept { return N; }
+
+	detail::__bit_word* __words()noexcept { return words; }
+	const detail::__bit_word* __words()const noexcept { return words; }
+	constexpr size_t __nwords()const noexcept { return N == 0 ? 0 : word_count; }
+};
+
+
+/**
+ * dynamic_bitset
+ * 位数在运行期确定，可增长
+ */
+class dynamic_bitset : public detail::__bitset_base<dynamic_bitset>
+{
+	friend class detail::__bitset_base<dynamic_bitset>;
+
+private:
+	std::vector<detail::__bit_word>	words;
+	size_t							nbits = 0;
+
+public:
+	using self = dynamic_bitset;
+
+	dynamic_bitset() = default;
+
+	explicit dynamic_bitset(size_t n, bool value = false)
+		: words(detail::__bit_word_count(n), value ? ~detail::__bit_word(0) : 0), nbits(n)
+	{
+		__sanitize();
+	}
+
+	size_t size()const noexcept { return nbits; }
+	SX_NODISCARD bool empty()const noexcept { return nbits == 0; }
+
+	void resize(size_t n, bool value = false)
+	{
+		SX_SCOPED_TIMER("dynamic_bitset::resize");
+		const size_t old = nbits;
+		words.resize(detail::__bit_word_count(n), value ? ~detail::__bit_word(0) : 0);
+		nbits = n;
+		if (value && n > old && old % detail::__bits_per_word != 0)
+			words[old / detail::__bits_per_word] |= ~detail::__bit_word(0) << (old % detail::__bits_per_word);
+		__sanitize();
+	}
+
+	void push_back(bool value)
+	{
+		if (nbits % detail::__bits_per_word == 0) words.push_back(0);
+		++nbits;
+		(*this)[nbits - 1] = value;
+	}
+
+	void clear()noexcept
+	{
+		words.clear();
+		nbits = 0;
+	}
+
+	void reserve(size_t n)
+	{
+		words.reserve(detail::__bit_word_count(n));
+	}
+
+	detail::__bit_word* __words()noexcept { return words.data(); }
+	const detail::__bit_word* __words()const noexcept { return words.data(); }
+	size_t __nwords()const noexcept { return words.size(); }
+};
+
+SX_NAMESPACE_END
+#endif	// end define _SX_BITSET_H_
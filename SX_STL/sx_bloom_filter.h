@@ -0,0 +1,491 @@
+﻿/**************************************************
+ * @brief   : 成员预检过滤器 bloom_filter 与 quotient_filter
+ * @file    : sx_bloom_filter.h
+ * @author  : 宋旭
+ * @date    : 2026年10月19日，00:47:15
+ **************************************************/
+
+#ifndef _SX_BLOOM_FILTER_H_
+#define _SX_BLOOM_FILTER_H_
+#include <cmath>			// log, ceil
+#include <cstdint>			// uint32_t, uint64_t
+#include <stdexcept>		// invalid_argument, length_error
+#include <vector>			// vector
+#include "sx_hash.h"
+#include "sx_trace.h"
+
+#ifdef __AVX2__
+#include <immintrin.h>		// AVX2
+#endif // __AVX2__
+
+SX_NAMESPACE_BEGIN
+
+/**
+ * bloom_filter
+ * 分块的 Bloom filter：哈希值的高 32 位选出一个 64 字节(一条缓存行)的块，
+ * 低 32 位分别乘以 8 个奇数常量，取积的高 6 位作为块内 8 个 64 位字中各置一位的位置
+ * 因此每次插入与查询只访问一条缓存行，开启 AVX2 时 8 个位置由一次向量乘法同时算出
+ *
+ * k 固定为 8；同样的空间下误判率略高于普通 Bloom filter，按期望元素个数构造时多分配约 10% 的空间补偿
+ * 只有误判，没有漏判；不支持删除，需要删除时使用 quotient_filter
+ * Hash 的结果应当充分混合，默认的 sx::hash 满足要求
+ */
+namespace detail {
+	struct alignas(64) __bloom_block
+	{
+		uint64_t words[8];
+	};
+
+	inline constexpr uint32_t __bloom_salt[8] = {
+		0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+		0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U
+	};
+
+	inline void __bloom_block_insert(__bloom_block& b, uint32_t h)noexcept
+	{
+#ifdef __AVX2__
+		__m256i idx = _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_set1_epi32(static_cast<int>(h)),
+			_mm256_loadu_si256(reinterpret_cast<const __m256i*>(__bloom_salt))), 26);
+		const __m256i one = _mm256_set1_epi64x(1);
+		__m256i m0 = _mm256_sllv_epi64(one, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(idx)));
+		__m256i m1 = _mm256_sllv_epi64(one, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(idx, 1)));
+		__m256i* p = reinterpret_cast<__m256i*>(b.words);
+		_mm256_store_si256(p, _mm256_or_si256(_mm256_load_si256(p), m0));
+		_mm256_store_si256(p + 1, _mm256_or_si256(_mm256_load_si256(p + 1), m1));
+#else
+		for (int i = 0; i < 8; ++i) b.words[i] |= uint64_t(1) << ((h * __bloom_salt[i]) >> 26);
+#endif // __AVX2__
+	}
+
+	inline bool __bloom_block_contains(const __bloom_block& b, uint32_t h)noexcept
+	{
+#ifdef __AVX2__
+		__m256i idx = _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_set1_epi32(static_cast<int>(h)),
+			_mm256_loadu_si256(reinterpret_cast<const __m256i*>(__bloom_salt))), 26);
+		const __m256i one = _mm256_set1_epi64x(1);
+		__m256i m0 = _mm256_sllv_epi64(one, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(idx)));
+		__m256i m1 = _mm256_sllv_epi64(one, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(idx, 1)));
+		const __m256i* p = reinterpret_cast<const __m256i*>(b.words);
+		// testc(a, m) 在 m 的置位全部包含于 a 时为 1
+		return (_mm256_testc_si256(_mm256_load_si256(p), m0) & _mm256_testc_si256(_mm256_load_si256(p + 1), m1)) != 0;
+#else
+		for (int i = 0; i < 8; ++i)
+		{
+			if ((b.words[i] & (uint64_t(1) << ((h * __bloom_salt[i]) >> 26))) == 0) return false;
+		}
+		return true;
+#endif // __AVX2__
+	}
+}
+
+template<class T, class Hash = sx::hash<T>>
+class bloom_filter
+{
+public:
+	using key_type		= T;
+	using hasher		= Hash;
+	using size_type		= size_t;
+
+	static constexpr size_t block_bytes = sizeof(detail::__bloom_block);
+
+private:
+	std::vector<detail::__bloom_block>	blocks;
+	Hash								hash_fn;
+
+public:
+	// 按期望的元素个数与误判率确定大小
+	explicit bloom_filter(size_t expected_items, double false_positive_rate = 0.01, const Hash& h = Hash())
+		: blocks(__block_count(expected_items, false_positive_rate)), hash_fn(h) {}
+
+	// 直接指定块数
+	static bloom_filter with_blocks(size_t block_count, const Hash& h = Hash())
+	{
+		bloom_filter f(0, 0.5, h);
+		f.blocks.assign(block_count == 0 ? 1 : block_count, detail::__bloom_block{});
+		return f;
+	}
+
+	void insert(const T& value) { insert_hash(static_cast<uint64_t>(hash_fn(value))); }
+	bool contains(const T& value)const { return contains_hash(static_cast<uint64_t>(hash_fn(value))); }
+
+	// 使用已经算好的哈希值，同一个过滤器中必须与 Hash 一致
+	void insert_hash(uint64_t h)noexcept
+	{
+		detail::__bloom_block_insert(blocks[__block_of(h)], static_cast<uint32_t>(h));
+	}
+
+	bool contains_hash(uint64_t h)const noexcept
+	{
+		return detail::__bloom_block_contains(blocks[__block_of(h)], static_cast<uint32_t>(h));
+	}
+
+	// 合并后的过滤器包含两者的元素，块数必须相同
+	void merge(const bloom_filter& rhs)
+	{
+		if (blocks.size() != rhs.blocks.size()) throw std::invalid_argument("bloom_filter: size mismatch");
+		for (size_t i = 0; i < blocks.size(); ++i)
+		{
+			for (int w = 0; w < 8; ++w) blocks[i].words[w] |= rhs.blocks[i].words[w];
+		}
+	}
+
+	void clear()noexcept
+	{
+		for (detail::__bloom_block& b : blocks) b = detail::__bloom_block{};
+	}
+
+	size_type block_count()const noexcept { return blocks.size(); }
+	size_type size_in_bytes()const noexcept { return blocks.size() * block_bytes; }
+
+	void swap(bloom_filter& rhs)noexcept
+	{
+		using std::swap;
+		blocks.swap(rhs.blocks);
+		swap(hash_fn, rhs.hash_fn);
+	}
+
+private:
+	// 以 fastrange 代替取模：(h32 * n) >> 32 均匀地落在 [0, n)
+	size_t __block_of(uint64_t h)const noexcept
+	{
+		return static_cast<size_t>(((h >> 32) * blocks.size()) >> 32);
+	}
+
+	static size_t __block_count(size_t n, double p)
+	{
+		if (!(p > 0.0 && p < 1.0)) throw std::invalid_argument("bloom_filter: false positive rate must be in (0, 1)");
+		const double ln2 = 0.6931471805599453;
+		double bits = -static_cast<double>(n) * std::log(p) / (ln2 * ln2) * 1.1;
+		double count = std::ceil(bits / (block_bytes * 8));
+		if (count > double(uint32_t(-1))) throw std::length_error("bloom_filter: too many blocks");
+		return count < 1.0 ? 1 : static_cast<size_t>(count);
+	}
+};
+
+template<class T, class Hash>
+inline void swap(bloom_filter<T, Hash>& lhs, bloom_filter<T, Hash>& rhs)noexcept
+{
+	lhs.swap(rhs);
+}
+
+
+/**
+ * quotient_filter
+ * 将哈希值的低 q + r 位作为指纹：高 q 位(商)是槽的下标，低 r 位(余数)存入槽中，
+ * 每个槽另有 3 个标志位 occupied, continuation, shifted，
+ * 同一个商的余数按升序连续存放(run)，被占用时向后移动，查询只扫描很短的连续区域
+ *
+ * 与 Bloom filter 相比支持删除：只能删除确实插入过的元素，否则可能删除另一个指纹相同的元素
+ * 同一个指纹可以插入多次，删除一次只去掉一份
+ * 装载率超过 3/4 时扩容：商多取一位，余数少一位，指纹不变，误判率约为 装载率 / 2^r，每扩容一次约翻倍
+ * 余数只剩 1 位时无法再扩容，抛出 length_error
+ *
+ * merge 将另一个过滤器的所有指纹插入本过滤器，两者的指纹位数 q + r 必须相同
+ */
+template<class T, class Hash = sx::hash<T>>
+class quotient_filter
+{
+public:
+	using key_type		= T;
+	using hasher		= Hash;
+	using size_type		= size_t;
+
+	static constexpr unsigned max_remainder_bits = 29;
+
+private:
+	// 槽的低 3 位为标志，其余为余数
+	static constexpr uint32_t occupied		= 1;
+	static constexpr uint32_t continuation	= 2;
+	static constexpr uint32_t shifted		= 4;
+
+	std::vector<uint32_t>	table;
+	unsigned				qbits;
+	unsigned				rbits;
+	size_t					entries = 0;
+	Hash					hash_fn;
+
+public:
+	explicit quotient_filter(size_t expected_items, unsigned remainder_bits = 16, const Hash& h = Hash())
+		: hash_fn(h)
+	{
+		if (remainder_bits == 0 || remainder_bits > max_remainder_bits)
+			throw std::invalid_argument("quotient_filter: remainder bits out of range");
+		unsigned q = 6;
+		while (q < 48 && (size_t(3) << q) / 4 < expected_items) ++q;
+		if (q + remainder_bits > 64) throw std::invalid_argument("quotient_filter: fingerprint wider than 64 bits");
+		qbits = q;
+		rbits = remainder_bits;
+		table.assign(size_t(1) << q, 0);
+	}
+
+	void insert(const T& value) { insert_hash(static_cast<uint64_t>(hash_fn(value))); }
+	bool contains(const T& value)const { return contains_hash(static_cast<uint64_t>(hash_fn(value))); }
+	bool erase(const T& value) { return erase_hash(static_cast<uint64_t>(hash_fn(value))); }
+
+	void insert_hash(uint64_t h)
+	{
+		if (entries + 1 > table.size() / 4 * 3) __grow();
+		__insert_fingerprint(h & __fingerprint_mask());
+	}
+
+	bool contains_hash(uint64_t h)const noexcept
+	{
+		const uint64_t fp = h & __fingerprint_mask();
+		const size_t fq = static_cast<size_t>(fp >> rbits);
+		const uint32_t fr = static_cast<uint32_t>(fp & __remainder_mask());
+		if (!(table[fq] & occupied)) return false;
+
+		size_t s = __find_run_index(fq);
+		do
+		{
+			uint32_t rem = __remainder(table[s]);
+			if (rem == fr) return true;
+			if (rem > fr) return false;
+			s = __incr(s);
+		} while (table[s] & continuation);
+		return false;
+	}
+
+	// 返回是否找到并删除了一份指纹
+	bool erase_hash(uint64_t h)noexcept
+	{
+		const uint64_t fp = h & __fingerprint_mask();
+		const size_t fq = static_cast<size_t>(fp >> rbits);
+		const uint32_t fr = static_cast<uint32_t>(fp & __remainder_mask());
+		uint32_t t_fq = table[fq];
+		if (!(t_fq & occupied) || entries == 0) return false;
+
+		size_t s = __find_run_index(fq);
+		uint32_t rem = 0;
+		do
+		{
+			rem = __remainder(table[s]);
+			if (rem >= fr) break;
+			s = __incr(s);
+		} while (table[s] & continuation);
+		if (rem != fr) return false;
+
+		const uint32_t kill = s == fq ? t_fq : table[s];
+		const bool replace_run_start = __is_run_start(kill);
+
+		// 删除的是 run 中唯一的元素时，商对应的槽不再 occupied
+		if (replace_run_start && !(table[__incr(s)] & continuation))
+		{
+			t_fq &= ~occupied;
+			table[fq] = t_fq;
+		}
+
+		__delete_entry(s, fq);
+
+		if (replace_run_start)
+		{
+			uint32_t next = table[s];
+			uint32_t updated = next;
+			if (updated & continuation) updated &= ~continuation;
+			if (s == fq && __is_run_start(updated)) updated &= ~shifted;
+			table[s] = updated;
+		}
+		--entries;
+		return true;
+	}
+
+	void merge(const quotient_filter& rhs)
+	{
+		if (qbits + rbits != rhs.qbits + rhs.rbits) throw std::invalid_argument("quotient_filter: fingerprint width mismatch");
+		if (this == &rhs)
+		{
+			quotient_filter copy(rhs);
+			merge(copy);
+			return;
+		}
+		rhs.__for_each_fingerprint([this](uint64_t fp)
+		{
+			if (entries + 1 > table.size() / 4 * 3) __grow();
+			__insert_fingerprint(fp);
+		});
+	}
+
+	void clear()noexcept
+	{
+		for (uint32_t& slot : table) slot = 0;
+		entries = 0;
+	}
+
+	size_type size()const noexcept { return entries; }
+	SX_NODISCARD bool empty()const noexcept { return entries == 0; }
+	size_type slot_count()const noexcept { return table.size(); }
+	unsigned quotient_bits()const noexcept { return qbits; }
+	unsigned remainder_bits()const noexcept { return rbits; }
+	size_type size_in_bytes()const noexcept { return table.size() * sizeof(uint32_t); }
+
+	void swap(quotient_filter& rhs)noexcept
+	{
+		using std::swap;
+		table.swap(rhs.table);
+		swap(qbits, rhs.qbits);
+		swap(rbits, rhs.rbits);
+		swap(entries, rhs.entries);
+		swap(hash_fn, rhs.hash_fn);
+	}
+
+private:
+	uint64_t __fingerprint_mask()const noexcept
+	{
+		const unsigned bits = qbits + rbits;
+		return bits == 64 ? ~uint64_t(0) : (uint64_t(1) << bits) - 1;
+	}
+
+	uint32_t __remainder_mask()const noexcept { return (uint32_t(1) << rbits) - 1; }
+
+	static uint32_t __remainder(uint32_t slot)noexcept { return slot >> 3; }
+	static bool __is_vacant(uint32_t slot)noexcept { return (slot & 7) == 0; }
+	static bool __is_run_start(uint32_t slot)noexcept { return !(slot & continuation) && (slot & (occupied | shifted)); }
+	static bool __is_cluster_start(uint32_t slot)noexcept { return (slot & 7) == occupied; }
+
+	size_t __incr(size_t i)const noexcept { return (i + 1) & (table.size() - 1); }
+	size_t __decr(size_t i)const noexcept { return (i - 1) & (table.size() - 1); }
+
+	// 商 fq 的 run 的起始槽：先退回到 cluster 的起点，再按 occupied 的槽数逐个跳过前面的 run
+	size_t __find_run_index(size_t fq)const noexcept
+	{
+		size_t b = fq;
+		while (table[b] & shifted) b = __decr(b);
+		size_t s = b;
+		while (b != fq)
+		{
+			do s = __incr(s); while (table[s] & continuation);
+			do b = __incr(b); while (!(table[b] & occupied));
+		}
+		return s;
+	}
+
+	// 在 s 处放入 slot，原有元素依次后移到下一个空槽；occupied 属于槽的位置而不是元素，不随之移动
+	void __insert_into(size_t s, uint32_t slot)noexcept
+	{
+		uint32_t cur = slot;
+		bool empty = false;
+		do
+		{
+			uint32_t prev = table[s];
+			empty = __is_vacant(prev);
+			if (!empty)
+			{
+				prev |= shifted;
+				if (prev & occupied)
+				{
+					cur |= occupied;
+					prev &= ~occupied;
+				}
+			}
+			table[s] = cur;
+			cur = prev;
+			s = __incr(s);
+		} while (!empty);
+	}
+
+	void __insert_fingerprint(uint64_t fp)noexcept
+	{
+		const size_t fq = static_cast<size_t>(fp >> rbits);
+		const uint32_t fr = static_cast<uint32_t>(fp & __remainder_mask());
+		const uint32_t t_fq = table[fq];
+		uint32_t entry = fr << 3;
+		++entries;
+
+		if (__is_vacant(t_fq))
+		{
+			table[fq] = entry | occupied;
+			return;
+		}
+		if (!(t_fq & occupied)) table[fq] = t_fq | occupied;
+
+		const size_t start = __find_run_index(fq);
+		size_t s = start;
+		if (t_fq & occupied)
+		{
+			// run 内按余数升序，相同的余数排在已有的之后
+			do
+			{
+				if (__remainder(table[s]) > fr) break;
+				s = __incr(s);
+			} while (table[s] & continuation);
+
+			if (s == start) table[start] |= continuation;
+			else entry |= continuation;
+		}
+		if (s != fq) entry |= shifted;
+		__insert_into(s, entry);
+	}
+
+	// 删除 s 处的元素，其后同一 cluster 中的元素前移一格，移回本来的槽时清除 shifted
+	void __delete_entry(size_t s, size_t quot)noexcept
+	{
+		uint32_t cur = table[s];
+		size_t sp = __incr(s);
+		const size_t orig = s;
+		for (;;)
+		{
+			uint32_t next = table[sp];
+			const bool cur_occupied = (cur & occupied) != 0;
+			if (__is_vacant(next) || __is_cluster_start(next) || sp == orig)
+			{
+				table[s] = cur_occupied ? occupied : 0;
+				return;
+			}
+
+			uint32_t updated = next;
+			if (__is_run_start(next))
+			{
+				do quot = __incr(quot); while (!(table[quot] & occupied));
+				if (cur_occupied && quot == s) updated &= ~shifted;
+			}
+			table[s] = cur_occupied ? (updated | occupied) : (updated & ~occupied);
+			s = sp;
+			sp = __incr(sp);
+			cur = next;
+		}
+	}
+
+	// 从一个空槽之后开始绕表一周，按 cluster 与 run 的结构还原每个元素的商
+	template<class Function>
+	void __for_each_fingerprint(Function f)const
+	{
+		if (entries == 0) return;
+		size_t start = 0;
+		while (!__is_vacant(table[start])) ++start;
+
+		size_t i = __incr(start);
+		size_t quot = 0;
+		for (size_t n = 0; n < table.size(); ++n, i = __incr(i))
+		{
+			const uint32_t slot = table[i];
+			if (__is_vacant(slot)) continue;
+			if (__is_cluster_start(slot)) quot = i;
+			else if (__is_run_start(slot))
+			{
+				do quot = __incr(quot); while (!(table[quot] & occupied));
+			}
+			f((uint64_t(quot) << rbits) | __remainder(slot));
+		}
+	}
+
+	// 商多取一位，余数少一位，指纹不变，重新插入所有指纹
+	void __grow()
+	{
+		SX_SCOPED_TIMER("quotient_filter::grow");
+		if (rbits <= 1) throw std::length_error("quotient_filter: cannot grow any further");
+		quotient_filter bigger(0, rbits - 1, hash_fn);
+		bigger.qbits = qbits + 1;
+		bigger.table.assign(size_t(1) << bigger.qbits, 0);
+		__for_each_fingerprint([&bigger](uint64_t fp) { bigger.__insert_fingerprint(fp); });
+		swap(bigger);
+	}
+};
+
+template<class T, class Hash>
+inline void swap(quotient_filter<T, Hash>& lhs, quotient_filter<T, Hash>& rhs)noexcept
+{
+	lhs.swap(rhs);
+}
+
+SX_NAMESPACE_END
+#endif	// end define _SX_BLOOM_FILTER_H_
@@ -0,0 +1,490 @@
+﻿/**************************************************
+ * @brief   : 协程 task 与 generator
+ * @file    : sx_coroutine.h
+ * @author  : 宋旭
+ * @date    : 2026年10月18日，23:52:30
+ **************************************************/
+
+#ifndef _SX_COROUTINE_H_
+#define _SX_COROUTINE_H_
+#include <coroutine>		// coroutine_handle, suspend_always
+#include <exception>		// exception_ptr, rethrow_exception, terminate
+#include <memory>			// addressof
+#include <new>				// operator new
+#include <semaphore>		// binary_semaphore
+#include <stdexcept>		// logic_error
+#include <type_traits>		// remove_reference_t, remove_cvref_t
+#include <utility>			// exchange, move
+#include <variant>			// variant, monostate
+#include "sx_iterator.h"
+
+SX_NAMESPACE_BEGIN
+
+/**
+ * task<T>		-- 惰性启动的协程，被 co_await 时才开始执行，结束时通过对称转移直接恢复等待者，
+ *				   长的 co_await 链不会使调用栈增长
+ * generator<T>	-- 由 co_yield 产生元素序列，迭代器为 sx 的 input_iterator_tag，
+ *				   可直接用于 sx::distance 等 sx 算法
+ * sync_wait	-- 在当前线程运行 task 直到完成并取得结果
+ *
+ * 协程帧从线程局部的缓存池中分配：帧大小按 64 字节向上取整分级，释放的帧按级缓存供下次复用，
+ * 每级最多缓存 64 个，超过 2048 字节的帧直接使用全局 operator new
+ * 帧可以在另一个线程中释放，此时进入释放线程的缓存池
+ * 线程的缓存池析构之后(例如静态的 task 在程序退出时析构)，该线程分配与释放帧直接使用全局 operator new/delete
+ */
+namespace detail {
+	class __frame_pool
+	{
+	private:
+		static constexpr size_t granularity		= 64;
+		static constexpr size_t class_count		= 32;
+		static constexpr size_t max_cached		= 64;
+
+		struct free_node
+		{
+			free_node* next;
+		};
+
+		free_node*	lists[class_count]	= {};
+		size_t		cached[class_count]	= {};
+
+		// 没有析构函数的线程局部变量在线程的整个生命周期内都可以访问
+		static inline thread_local bool destroyed = false;
+
+		static size_t __class_of(size_t n)noexcept { return (n + granularity - 1) / granularity - 1; }
+
+		// 实际申请的字节数，可缓存的帧按所属类别的大小申请
+		static size_t __block_size(size_t n)noexcept
+		{
+			const size_t c = __class_of(n);
+			return c < class_count ? (c + 1) * granularity : n;
+		}
+
+	public:
+		__frame_pool() = default;
+		__frame_pool(const __frame_pool&) = delete;
+		__frame_pool& operator=(const __frame_pool&) = delete;
+
+		~__frame_pool()
+		{
+			destroyed = true;
+			for (free_node*& head : lists)
+			{
+				while (head != nullptr)
+				{
+					free_node* next = head->next;
+					::operator delete(static_cast<void*>(head));
+					head = next;
+				}
+			}
+		}
+
+		void* allocate(size_t n)
+		{
+			const size_t c = __class_of(n);
+			if (c < class_count)
+			{
+				if (free_node* p = lists[c])
+				{
+					lists[c] = p->next;
+					--cached[c];
+					return p;
+				}
+			}
+			return allocate_unpooled(n);
+		}
+
+		/**
+		 * 不经过缓存直接申请，用于本线程的池已析构的情形
+		 * 大小与 allocate 相同，释放时可以被其他线程的池缓存并按类别的大小复用
+		 */
+		static void* allocate_unpooled(size_t n)
+		{
+			return ::operator new(__block_size(n));
+		}
+
+		void deallocate(void* p, size_t n)noexcept
+		{
+			const size_t c = __class_of(n);
+			if (c >= class_count || cached[c] >= max_cached)
+			{
+				::operator delete(p);
+				return;
+			}
+			lists[c] = ::new (p) free_node{ lists[c] };
+			++cached[c];
+		}
+
+		// 本线程的缓存池，已析构时返回 nullptr
+		static __frame_pool* local()noexcept
+		{
+			if (destroyed) return nullptr;
+			thread_local __frame_pool pool;
+			return &pool;
+		}
+	};
+
+	// 协程帧从缓存池分配的 promise 基类
+	struct __pooled_promise
+	{
+		static void* operator new(size_t n)
+		{
+			if (__frame_pool* pool = __frame_pool::local()) return pool->allocate(n);
+			return __frame_pool::allocate_unpooled(n);
+		}
+
+		static void operator delete(void* p, size_t n)noexcept
+		{
+			if (__frame_pool* pool = __frame_pool::local()) pool->deallocate(p, n);
+			else ::operator delete(p);
+		}
+	};
+}
+
+
+template<class T = void>
+class task;
+
+namespace detail {
+	// task 结束时恢复等待者，没有等待者时返回 noop_coroutine
+	struct __task_final_awaiter
+	{
+		bool await_ready()const noexcept { return false; }
+
+		template<class Promise>
+		std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> h)noexcept
+		{
+			std::coroutine_handle<> next = h.promise().continuation;
+			return next ? next : std::noop_coroutine();
+		}
+
+		void await_resume()const noexcept {}
+	};
+
+	template<class T>
+	struct __task_promise_base : __pooled_promise
+	{
+		std::coroutine_handle<> continuation;
+
+		std::suspend_always initial_suspend()const noexcept { return {}; }
+		__task_final_awaiter final_suspend()const noexcept { return {}; }
+	};
+
+	template<class T>
+	struct __task_promise : __task_promise_base<T>
+	{
+		std::variant<std::monostate, T, std::exception_ptr> result;
+
+		task<T> get_return_object()noexcept;
+
+		template<class U>
+		void return_value(U&& value)
+		{
+			result.template emplace<1>(std::forward<U>(value));
+		}
+
+		void unhandled_exception()noexcept { result.template emplace<2>(std::current_exception()); }
+
+		T& get()&
+		{
+			if (result.index() == 2) std::rethrow_exception(std::get<2>(result));
+			return std::get<1>(result);
+		}
+
+		T&& get()&&
+		{
+			if (result.index() == 2) std::rethrow_exception(std::get<2>(result));
+			return std::get<1>(std::move(result));
+		}
+	};
+
+	template<>
+	struct __task_promise<void> : __task_promise_base<void>
+	{
+		std::exception_ptr exception;
+
+		task<void> get_return_object()noexcept;
+
+		void return_void()noexcept {}
+		void unhandled_exception()noexcept { exception = std::current_exception(); }
+
+		void get()
+		{
+			if (exception) std::rethrow_exception(exception);
+		}
+	};
+}
+
+
+/**
+ * task
+ */
+template<class T>
+class task
+{
+	static_assert(!std::is_reference_v<T>, "task<T&> is not supported");
+
+public:
+	using promise_type	= detail::__task_promise<T>;
+	using handle_type	= std::coroutine_handle<promise_type>;
+
+private:
+	handle_type handle;
+
+	template<bool Rvalue>
+	struct awaiter
+	{
+		handle_type handle;
+
+		bool await_ready()const noexcept { return !handle || handle.done(); }
+
+		// 对称转移：挂起等待者的同时直接恢复被等待的 task
+		std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting)noexcept
+		{
+			handle.promise().continuation = awaiting;
+			return handle;
+		}
+
+		decltype(auto) await_resume()
+		{
+			if (!handle) throw std::logic_error("task: co_await on an empty task");
+			if constexpr (Rvalue) return std::move(handle.promise()).get();
+			else return handle.promise().get();
+		}
+	};
+
+public:
+	task()noexcept = default;
+	explicit task(handle_type h)noexcept : handle(h) {}
+
+	task(task&& rhs)noexcept : handle(std::exchange(rhs.handle, nullptr)) {}
+
+	task& operator=(task&& rhs)noexcept
+	{
+		if (this != &rhs)
+		{
+			if (handle) handle.destroy();
+			handle = std::exchange(rhs.handle, nullptr);
+		}
+		return *this;
+	}
+
+	task(const task&) = delete;
+	task& operator=(const task&) = delete;
+
+	~task()
+	{
+		if (handle) handle.destroy();
+	}
+
+	bool valid()const noexcept { return static_cast<bool>(handle); }
+	bool done()const noexcept { return !handle || handle.done(); }
+
+	awaiter<false> operator co_await()& noexcept { return awaiter<false>{ handle }; }
+	awaiter<true> operator co_await()&& noexcept { return awaiter<true>{ handle }; }
+};
+
+namespace detail {
+	template<class T>
+	inline task<T> __task_promise<T>::get_return_object()noexcept
+	{
+		return task<T>(std::coroutine_handle<__task_promise<T>>::from_promise(*this));
+	}
+
+	inline task<void> __task_promise<void>::get_return_object()noexcept
+	{
+		return task<void>(std::coroutine_handle<__task_promise<void>>::from_promise(*this));
+	}
+
+	// sync_wait 使用的驱动协程，结束时通知等待的线程
+	struct __sync_driver
+	{
+		struct promise_type : __pooled_promise
+		{
+			std::binary_semaphore* done = nullptr;
+
+			__sync_driver get_return_object()noexcept
+			{
+				return __sync_driver{ std::coroutine_handle<promise_type>::from_promise(*this) };
+			}
+
+			std::suspend_always initial_suspend()const noexcept { return {}; }
+
+			auto final_suspend()const noexcept
+			{
+				struct notifier
+				{
+					bool await_ready()const noexcept { return false; }
+					void await_suspend(std::coroutine_handle<promise_type> h)const noexcept { h.promise().done->release(); }
+					void await_resume()const noexcept {}
+				};
+				return notifier{};
+			}
+
+			void return_void()noexcept {}
+			void unhandled_exception()noexcept { std::terminate(); }
+		};
+
+		std::coroutine_handle<promise_type> handle;
+	};
+
+	template<class T>
+	__sync_driver __sync_drive(task<T>& t, std::variant<std::monostate, std::conditional_t<std::is_void_v<T>, std::monostate, T>, std::exception_ptr>& out)
+	{
+		try
+		{
+			if constexpr (std::is_void_v<T>)
+			{
+				co_await std::move(t);
+				out.template emplace<1>();
+			}
+			else
+			{
+				out.template emplace<1>(co_await std::move(t));
+			}
+		}
+		catch (...)
+		{
+			out.template emplace<2>(std::current_exception());
+		}
+	}
+}
+
+// 在当前线程运行 task 直到完成；task 挂起在其他线程恢复的操作上时阻塞等待
+template<class T>
+T sync_wait(task<T> t)
+{
+	std::variant<std::monostate, std::conditional_t<std::is_void_v<T>, std::monostate, T>, std::exception_ptr> out;
+	std::binary_semaphore done(0);
+	detail::__sync_driver driver = detail::__sync_drive(t, out);
+	driver.handle.promise().done = &done;
+	driver.handle.resume();
+	done.acquire();
+	driver.handle.destroy();
+
+	if (out.index() == 2) std::rethrow_exception(std::get<2>(out));
+	if constexpr (!std::is_void_v<T>) return std::get<1>(std::move(out));
+}
+
+
+/**
+ * generator
+ */
+template<class T>
+class generator
+{
+public:
+	using value_type	= std::remove_cvref_t<T>;
+	using reference		= std::remove_reference_t<T>&;
+	using pointer		= std::remove_reference_t<T>*;
+
+	struct promise_type : detail::__pooled_promise
+	{
+		pointer				current = nullptr;
+		std::exception_ptr	exception;
+
+		generator get_return_object()noexcept
+		{
+			return generator(std::coroutine_handle<promise_type>::from_promise(*this));
+		}
+
+		std::suspend_always initial_suspend()const noexcept { return {}; }
+		std::suspend_always final_suspend()const noexcept { return {}; }
+
+		// co_yield 的操作数在挂起期间一直存在，只保存地址
+		std::suspend_always yield_value(std::remove_reference_t<T>& value)noexcept
+		{
+			current = std::addressof(value);
+			return {};
+		}
+
+		std::suspend_always yield_value(std::remove_reference_t<T>&& value)noexcept
+		{
+			current = std::addressof(value);
+			return {};
+		}
+
+		void return_void()noexcept {}
+		void unhandled_exception()noexcept { exception = std::current_exception(); }
+
+		// generator 中不能使用 co_await
+		template<class U>
+		std::suspend_never await_transform(U&&) = delete;
+	};
+
+	using handle_type = std::coroutine_handle<promise_type>;
+
+	// 默认构造的迭代器表示末尾
+	class iterator : public sx::iterator<input_iterator_tag, value_type, ptrdiff_t, pointer, reference>
+	{
+	private:
+		handle_type handle;
+
+	public:
+		using self = iterator;
+
+		iterator() = default;
+		explicit iterator(handle_type h)noexcept : handle(h) {}
+
+		reference operator*()const noexcept { return *handle.promise().current; }
+		pointer operator->()const noexcept { return handle.promise().current; }
+
+		self& operator++()
+		{
+			handle.resume();
+			if (handle.done())
+			{
+				std::exception_ptr e = handle.promise().exception;
+				handle = nullptr;
+				if (e) std::rethrow_exception(e);
+			}
+			return *this;
+		}
+
+		void operator++(int) { ++*this; }
+
+		bool operator==(const self& rhs)const noexcept { return handle == rhs.handle; }
+		bool operator!=(const self& rhs)const noexcept { return handle != rhs.handle; }
+	};
+
+private:
+	handle_type handle;
+
+public:
+	generator()noexcept = default;
+	explicit generator(handle_type h)noexcept : handle(h) {}
+
+	generator(generator&& rhs)noexcept : handle(std::exchange(rhs.handle, nullptr)) {}
+
+	generator& operator=(generator&& rhs)noexcept
+	{
+		if (this != &rhs)
+		{
+			if (handle) handle.destroy();
+			handle = std::exchange(rhs.handle, nullptr);
+		}
+		return *this;
+	}
+
+	generator(const generator&) = delete;
+	generator& operator=(const generator&) = delete;
+
+	~generator()
+	{
+		if (handle) handle.destroy();
+	}
+
+	// 只能调用一次，开始执行到第一个 co_yield
+	iterator begin()
+	{
+		if (!handle) return iterator();
+		iterator it(handle);
+		++it;
+		return it;
+	}
+
+	iterator end()noexcept { return iterator(); }
+};
+
+SX_NAMESPACE_END
+#endif	// end define _SX_COROUTINE_H_
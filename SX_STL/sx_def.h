@@ -49,4 +49,13 @@
 }
 */
 
+
+/**
+ * 预处理相关
+ */
+
+// 先展开参数再拼接
+#define SX_CONCAT_IMPL(a, b) a##b
+#define SX_CONCAT(a, b) SX_CONCAT_IMPL(a, b)
+
 #endif	// end define _SX_DEF_H_
\ No newline at end of file
@@ -0,0 +1,367 @@
+﻿/**************************************************
+ * @brief   : 编译期构造的完美哈希表 frozen_map 与 frozen_set
+ * @file    : sx_frozen_map.h
+ * @author  : 宋旭
+ * @date    : 2026年10月19日，01:26:50
+ **************************************************/
+
+#ifndef _SX_FROZEN_MAP_H_
+#define _SX_FROZEN_MAP_H_
+#include <algorithm>		// sort
+#include <array>			// array
+#include <cstdint>			// uint32_t, uint64_t
+#include <stdexcept>		// invalid_argument, out_of_range
+#include <string_view>		// string_view
+#include <utility>			// index_sequence
+#include "sx_type_traits.h"
+#include "sx_utility.h"
+
+SX_NAMESPACE_BEGIN
+
+/**
+ * frozen_map / frozen_set
+ * 由一组固定的键在编译期构造，之后只读
+ * 键只能是整数或字符串字面量(以 std::string_view 保存)，由 is_frozen_key 限定
+ *
+ * 使用 CHD 方式的两级完美哈希：键先求一次基础哈希 h，
+ * 由 h 选出一个桶，桶中记录一个种子，h 与种子混合后得到槽的下标，槽中保存元素的下标
+ * 构造时按桶的大小从大到小为每个桶寻找种子，使桶内所有键落在互不相同的空槽中，
+ * 因此查找只需一次哈希与一次键的比较，没有探测
+ *
+ * 槽数为不小于 5N/4 的 2 的幂，桶数约为 N/2，构造的复杂度为 O(N log N)
+ * 键重复时构造失败：在常量表达式中为编译错误，运行期构造时抛出 invalid_argument
+ * N 为 0 时为空的 frozen_map / frozen_set，由 make_frozen_map<K, V>() / make_frozen_set<K>() 得到
+ * 元素按给出的顺序保存，迭代顺序即给出的顺序
+ *
+ * constexpr auto methods = sx::make_frozen_map<std::string_view, int>({ {"GET", 1}, {"POST", 2} });
+ * static_assert(methods.at("POST") == 2);
+ */
+namespace detail {
+	// murmur3 的 fmix64，是双射
+	constexpr uint64_t __frozen_mix(uint64_t x)noexcept
+	{
+		x ^= x >> 33;
+		x *= 0xff51afd7ed558ccdULL;
+		x ^= x >> 33;
+		x *= 0xc4ceb9fe1a85ec53ULL;
+		x ^= x >> 33;
+		return x;
+	}
+
+	// 基础哈希：整数为其值本身，字符串为 FNV-1a
+	template<class K>
+	constexpr uint64_t __frozen_key_hash(const K& key)noexcept
+	{
+		if constexpr (is_same_v<K, std::string_view>)
+		{
+			uint64_t h = 0xcbf29ce484222325ULL;
+			for (char c : key)
+			{
+				h ^= static_cast<unsigned char>(c);
+				h *= 0x100000001b3ULL;
+			}
+			return h;
+		}
+		else
+		{
+			return static_cast<uint64_t>(key);
+		}
+	}
+
+	constexpr size_t __frozen_pow2(size_t n)noexcept
+	{
+		size_t p = 1;
+		while (p < n) p <<= 1;
+		return p;
+	}
+
+	// 每个桶尝试的种子个数上限，小于编译器对常量表达式中单个循环的迭代次数限制(GCC 默认为 262144)
+	// 槽数不小于 5N/4，每个桶通常只需尝试几个种子
+	constexpr uint64_t __frozen_max_seed = uint64_t(1) << 16;
+
+	template<class T, size_t N, size_t... I>
+	constexpr std::array<T, N> __frozen_to_array(const T (&items)[N], std::index_sequence<I...>)
+	{
+		return std::array<T, N>{ { items[I]... } };
+	}
+
+	/**
+	 * 完美哈希的索引部分，与元素分开保存
+	 * slots 中保存元素的下标，N 表示空槽
+	 */
+	template<class K, size_t N>
+	class __frozen_index
+	{
+	public:
+		static constexpr size_t slot_count		= __frozen_pow2(N + N / 4 + 1);
+		static constexpr size_t bucket_count	= __frozen_pow2(N / 2 + 1);
+		static constexpr uint32_t empty_slot	= static_cast<uint32_t>(N);
+
+		static_assert(N < UINT32_MAX, "too many keys for frozen_map");
+
+	private:
+		std::array<uint32_t, slot_count>	slots{};
+		std::array<uint64_t, bucket_count>	seeds{};
+
+		static constexpr size_t __bucket(uint64_t h)noexcept
+		{
+			return static_cast<size_t>(__frozen_mix(h) & (bucket_count - 1));
+		}
+
+		static constexpr size_t __slot(uint64_t h, uint64_t seed)noexcept
+		{
+			return static_cast<size_t>(__frozen_mix(h ^ seed) & (slot_count - 1));
+		}
+
+	public:
+		// key_at(i) 返回第 i 个元素的键
+		template<class KeyAt>
+		constexpr explicit __frozen_index(KeyAt key_at)
+		{
+			std::array<uint64_t, N> hashes{};
+			for (size_t i = 0; i < N; ++i) hashes[i] = __frozen_key_hash(key_at(i));
+
+			// 元素下标按 (桶, 哈希值) 排序：同一个桶的元素相邻，相同的键哈希值相同，也相邻
+			std::array<size_t, N> sorted{};
+			for (size_t i = 0; i < N; ++i) sorted[i] = i;
+			std::sort(sorted.begin(), sorted.end(), [&hashes](size_t a, size_t b) {
+				const size_t ba = __bucket(hashes[a]), bb = __bucket(hashes[b]);
+				return ba != bb ? ba < bb : hashes[a] < hashes[b];
+			});
+
+			// 只有哈希值相同的相邻元素需要比较键
+			for (size_t i = 0; i < N; ++i)
+			{
+				for (size_t j = i + 1; j < N && hashes[sorted[j]] == hashes[sorted[i]]; ++j)
+				{
+					if (key_at(sorted[i]) == key_at(sorted[j])) throw std::invalid_argument("frozen_map: duplicate key");
+				}
+			}
+
+			// 第 b 个桶的元素为 sorted[first[b], first[b + 1])
+			std::array<size_t, bucket_count + 1> first{};
+			for (size_t i = 0; i < N; ++i) ++first[__bucket(hashes[i]) + 1];
+			for (size_t b = 0; b < bucket_count; ++b) first[b + 1] += first[b];
+
+			// 桶按大小从大到小处理，大的桶先占用空槽更容易成功
+			std::array<size_t, bucket_count> order{};
+			for (size_t b = 0; b < bucket_count; ++b) order[b] = b;
+			std::sort(order.begin(), order.end(), [&first](size_t a, size_t b) {
+				const size_t na = first[a + 1] - first[a], nb = first[b + 1] - first[b];
+				return na != nb ? na > nb : a < b;
+			});
+
+			for (uint32_t& s : slots) s = empty_slot;
+
+			std::array<size_t, N> chosen{};
+			for (size_t b : order)
+			{
+				const size_t* members = sorted.data() + first[b];
+				const size_t count = first[b + 1] - first[b];
+				if (count == 0) break;
+
+				for (uint64_t d = 1;; ++d)
+				{
+					if (d > __frozen_max_seed) throw std::invalid_argument("frozen_map: no perfect hash found");
+					const uint64_t seed = d * 0x9e3779b97f4a7c15ULL;
+					bool ok = true;
+					for (size_t m = 0; m < count && ok; ++m)
+					{
+						chosen[m] = __slot(hashes[members[m]], seed);
+						if (slots[chosen[m]] != empty_slot) ok = false;
+						for (size_t n = 0; n < m && ok; ++n)
+						{
+							if (chosen[n] == chosen[m]) ok = false;
+						}
+					}
+					if (!ok) continue;
+
+					for (size_t m = 0; m < count; ++m) slots[chosen[m]] = static_cast<uint32_t>(members[m]);
+					seeds[b] = seed;
+					break;
+				}
+			}
+		}
+
+		// 键对应的元素下标；键不存在时返回某个元素的下标或 N，需再比较一次键
+		constexpr size_t lookup(const K& key)const noexcept
+		{
+			const uint64_t h = __frozen_key_hash(key);
+			return slots[__slot(h, seeds[__bucket(h)])];
+		}
+	};
+}
+
+
+template<class K, class V, size_t N>
+class frozen_map
+{
+	static_assert(is_frozen_key_v<K>, "frozen_map keys must be integral or std::string_view");
+
+public:
+	using key_type			= K;
+	using mapped_type		= V;
+	using value_type		= pair<K, V>;
+	using size_type			= size_t;
+	using const_reference	= const value_type&;
+	using const_iterator	= const value_type*;
+	using iterator			= const_iterator;
+
+private:
+	std::array<value_type, N>		items;
+	detail::__frozen_index<K, N>	index;
+
+public:
+	constexpr explicit frozen_map(const value_type (&init)[N])
+		: items(detail::__frozen_to_array(init, std::make_index_sequence<N>())),
+		index([&init](size_t i) { return init[i].first; }) {}
+
+	constexpr const_iterator begin()const noexcept { return items.data(); }
+	constexpr const_iterator end()const noexcept { return items.data() + N; }
+
+	constexpr size_type size()const noexcept { return N; }
+	SX_NODISCARD constexpr bool empty()const noexcept { return N == 0; }
+
+	constexpr const_iterator find(const K& key)const noexcept
+	{
+		const size_t i = index.lookup(key);
+		return i < N && items[i].first == key ? begin() + i : end();
+	}
+
+	constexpr bool contains(const K& key)const noexcept { return find(key) != end(); }
+	constexpr size_type count(const K& key)const noexcept { return contains(key) ? 1 : 0; }
+
+	constexpr const V& at(const K& key)const
+	{
+		const_iterator it = find(key);
+		if (it == end()) throw std::out_of_range("frozen_map::at: key not found");
+		return it->second;
+	}
+};
+
+
+template<class K, size_t N>
+class frozen_set
+{
+	static_assert(is_frozen_key_v<K>, "frozen_set keys must be integral or std::string_view");
+
+public:
+	using key_type			= K;
+	using value_type		= K;
+	using size_type			= size_t;
+	using const_reference	= const value_type&;
+	using const_iterator	= const value_type*;
+	using iterator			= const_iterator;
+
+private:
+	std::array<K, N>				keys;
+	detail::__frozen_index<K, N>	index;
+
+public:
+	constexpr explicit frozen_set(const K (&init)[N])
+		: keys(detail::__frozen_to_array(init, std::make_index_sequence<N>())),
+		index([&init](size_t i) { return init[i]; }) {}
+
+	constexpr const_iterator begin()const noexcept { return keys.data(); }
+	constexpr const_iterator end()const noexcept { return keys.data() + N; }
+
+	constexpr size_type size()const noexcept { return N; }
+	SX_NODISCARD constexpr bool empty()const noexcept { return N == 0; }
+
+	constexpr const_iterator find(const K& key)const noexcept
+	{
+		const size_t i = index.lookup(key);
+		return i < N && keys[i] == key ? begin() + i : end();
+	}
+
+	constexpr bool contains(const K& key)const noexcept { return find(key) != end(); }
+	constexpr size_type count(const K& key)const noexcept { return contains(key) ? 1 : 0; }
+};
+
+
+// 空的 frozen_map 与 frozen_set，不能由长度为 0 的数组构造
+template<class K, class V>
+class frozen_map<K, V, 0>
+{
+	static_assert(is_frozen_key_v<K>, "frozen_map keys must be integral or std::string_view");
+
+public:
+	using key_type			= K;
+	using mapped_type		= V;
+	using value_type		= pair<K, V>;
+	using size_type			= size_t;
+	using const_reference	= const value_type&;
+	using const_iterator	= const value_type*;
+	using iterator			= const_iterator;
+
+	constexpr frozen_map()noexcept = default;
+
+	constexpr const_iterator begin()const noexcept { return nullptr; }
+	constexpr const_iterator end()const noexcept { return nullptr; }
+
+	constexpr size_type size()const noexcept { return 0; }
+	SX_NODISCARD constexpr bool empty()const noexcept { return true; }
+
+	constexpr const_iterator find(const K&)const noexcept { return end(); }
+	constexpr bool contains(const K&)const noexcept { return false; }
+	constexpr size_type count(const K&)const noexcept { return 0; }
+
+	constexpr const V& at(const K&)const
+	{
+		throw std::out_of_range("frozen_map::at: key not found");
+	}
+};
+
+template<class K>
+class frozen_set<K, 0>
+{
+	static_assert(is_frozen_key_v<K>, "frozen_set keys must be integral or std::string_view");
+
+public:
+	using key_type			= K;
+	using value_type		= K;
+	using size_type			= size_t;
+	using const_reference	= const value_type&;
+	using const_iterator	= const value_type*;
+	using iterator			= const_iterator;
+
+	constexpr frozen_set()noexcept = default;
+
+	constexpr const_iterator begin()const noexcept { return nullptr; }
+	constexpr const_iterator end()const noexcept { return nullptr; }
+
+	constexpr size_type size()const noexcept { return 0; }
+	SX_NODISCARD constexpr bool empty()const noexcept { return true; }
+
+	constexpr const_iterator find(const K&)const noexcept { return end(); }
+	constexpr bool contains(const K&)const noexcept { return false; }
+	constexpr size_type count(const K&)const noexcept { return 0; }
+};
+
+
+template<class K, class V, size_t N>
+constexpr frozen_map<K, V, N> make_frozen_map(const pair<K, V> (&items)[N])
+{
+	return frozen_map<K, V, N>(items);
+}
+
+template<class K, size_t N>
+constexpr frozen_set<K, N> make_frozen_set(const K (&keys)[N])
+{
+	return frozen_set<K, N>(keys);
+}
+
+template<class K, class V>
+constexpr frozen_map<K, V, 0> make_frozen_map()noexcept
+{
+	return frozen_map<K, V, 0>();
+}
+
+template<class K>
+constexpr frozen_set<K, 0> make_frozen_set()noexcept
+{
+	return frozen_set<K, 0>();
+}
+
+SX_NAMESPACE_END
+#endif	// end define _SX_FROZEN_MAP_H_
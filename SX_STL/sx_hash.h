@@ -0,0 +1,235 @@
+﻿/**************************************************
+ * @brief   : 非加密的快速哈希函数
+ * @file    : sx_hash.h
+ * @author  : 宋旭
+ * @date    : 2026年10月18日，21:36:12
+ **************************************************/
+
+#ifndef _SX_HASH_H_
+#define _SX_HASH_H_
+#include <bit>				// bit_cast
+#include <cstdint>			// uint64_t
+#include <cstring>			// memcpy
+#include <string>			// string
+#include <string_view>		// string_view
+#include <type_traits>		// conditional_t
+#include "sx_type_traits.h"
+#include "sx_utility.h"
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>			// _umul128
+#endif // _MSC_VER
+
+SX_NAMESPACE_BEGIN
+
+/**
+ * hash
+ * 基于 wyhash 的混合函数：64 位乘法得到 128 位结果后将高低两半异或
+ * 与 std::hash 对整数的恒等映射不同，相邻的整数会被打散到整个 64 位空间，
+ * 开放寻址的哈希表以低位取下标时不会出现成片的聚集
+ *
+ * hash_mix		-- 整数的混合
+ * hash_bytes	-- 任意字节序列，每次读取 64 位，长输入按 3 路独立的乘法并行处理
+ *				   处理输入块时乘积异或回乘数，某个块等于密钥时不会丢失之前的状态
+ * hash_combine	-- 合并两个哈希值
+ *
+ * 整数，枚举，指针，浮点数由 hash 的主模板根据类型分派，字符串另有特化
+ * 结果不保证在不同版本间稳定，不能用于持久化的数据(序列化使用 sx_serialize.h 中的哈希)
+ */
+
+namespace detail {
+	inline constexpr uint64_t __hash_secret[4] = {
+		0x2d358dccaa6c78a5ULL, 0x8bb84b93962eacc9ULL, 0x4b33a62ed433d4a3ULL, 0x4d5a2da51de1aa47ULL
+	};
+
+	// a * b 的 128 位结果，低 64 位存入 a，高 64 位存入 b
+	inline void __hash_mum(uint64_t& a, uint64_t& b)noexcept
+	{
+#if defined(_MSC_VER) && !defined(__clang__)
+		a = _umul128(a, b, &b);
+#else
+		__uint128_t r = static_cast<__uint128_t>(a) * b;
+		a = static_cast<uint64_t>(r);
+		b = static_cast<uint64_t>(r >> 64);
+#endif // _MSC_VER
+	}
+
+	inline uint64_t __hash_mix(uint64_t a, uint64_t b)noexcept
+	{
+		__hash_mum(a, b);
+		return a ^ b;
+	}
+
+	// 乘积的低位与高位分别异或回 a 与 b，而不是替换它们
+	// 输入块恰好等于密钥时一个乘数为 0，替换会丢失此前累积的全部状态，使不同的前缀发生碰撞
+	inline void __hash_mum_keep(uint64_t& a, uint64_t& b)noexcept
+	{
+		uint64_t lo = a, hi = b;
+		__hash_mum(lo, hi);
+		a ^= lo;
+		b ^= hi;
+	}
+
+	inline uint64_t __hash_mix_keep(uint64_t a, uint64_t b)noexcept
+	{
+		__hash_mum_keep(a, b);
+		return a ^ b;
+	}
+
+	inline uint64_t __hash_read64(const unsigned char* p)noexcept
+	{
+		uint64_t v;
+		std::memcpy(&v, p, 8);
+		return v;
+	}
+
+	inline uint64_t __hash_read32(const unsigned char* p)noexcept
+	{
+		uint32_t v;
+		std::memcpy(&v, p, 4);
+		return v;
+	}
+
+	// 1 ~ 3 个字节
+	inline uint64_t __hash_read_small(const unsigned char* p, size_t n)noexcept
+	{
+		return (static_cast<uint64_t>(p[0]) << 16) | (static_cast<uint64_t>(p[n >> 1]) << 8) | p[n - 1];
+	}
+}
+
+// 一次乘法的高位只受输入低位的影响，需要两轮才能使每一位输入影响每一位输出
+inline uint64_t hash_mix(uint64_t x, uint64_t seed = 0)noexcept
+{
+	uint64_t a = x ^ detail::__hash_secret[0];
+	uint64_t b = seed ^ detail::__hash_secret[1];
+	detail::__hash_mum(a, b);
+	return detail::__hash_mix(a ^ detail::__hash_secret[0], b ^ detail::__hash_secret[1]);
+}
+
+inline uint64_t hash_bytes(const void* data, size_t len, uint64_t seed = 0)noexcept
+{
+	using detail::__hash_secret;
+	using detail::__hash_read64;
+	using detail::__hash_read32;
+
+	const unsigned char* p = static_cast<const unsigned char*>(data);
+	seed ^= detail::__hash_mix(seed ^ __hash_secret[0], __hash_secret[1]);
+
+	uint64_t a, b;
+	if (len <= 16)
+	{
+		if (len >= 4)
+		{
+			// 4 ~ 16 字节用首尾各两次 32 位读取覆盖，可能重叠
+			const size_t off = (len >> 3) << 2;
+			a = (__hash_read32(p) << 32) | __hash_read32(p + off);
+			b = (__hash_read32(p + len - 4) << 32) | __hash_read32(p + len - 4 - off);
+		}
+		else if (len > 0)
+		{
+			a = detail::__hash_read_small(p, len);
+			b = 0;
+		}
+		else
+		{
+			a = b = 0;
+		}
+	}
+	else
+	{
+		size_t i = len;
+		if (i > 48)
+		{
+			// 三条相互独立的乘法链，乘法单元不必等待上一次的结果
+			uint64_t see1 = seed, see2 = seed;
+			do
+			{
+				seed = detail::__hash_mix_keep(__hash_read64(p) ^ __hash_secret[1], __hash_read64(p + 8) ^ seed);
+				see1 = detail::__hash_mix_keep(__hash_read64(p + 16) ^ __hash_secret[2], __hash_read64(p + 24) ^ see1);
+				see2 = detail::__hash_mix_keep(__hash_read64(p + 32) ^ __hash_secret[3], __hash_read64(p + 40) ^ see2);
+				p += 48;
+				i -= 48;
+			} while (i > 48);
+			seed ^= see1 ^ see2;
+		}
+		while (i > 16)
+		{
+			seed = detail::__hash_mix_keep(__hash_read64(p) ^ __hash_secret[1], __hash_read64(p + 8) ^ seed);
+			p += 16;
+			i -= 16;
+		}
+		// 最后 16 字节，与前面的块可能重叠
+		a = __hash_read64(p + i - 16);
+		b = __hash_read64(p + i - 8);
+	}
+
+	a ^= __hash_secret[1];
+	b ^= seed;
+	detail::__hash_mum_keep(a, b);
+	return detail::__hash_mix(a ^ __hash_secret[0] ^ len, b ^ __hash_secret[1]);
+}
+
+inline size_t hash_combine(size_t seed, size_t value)noexcept
+{
+	return static_cast<size_t>(hash_mix(value, seed));
+}
+
+
+// 整数，枚举，指针，浮点数
+template<class T>
+struct hash
+{
+	static_assert(is_integral_v<T> || is_enum_v<T> || is_pointer_v<T> || is_floating_point_v<T>,
+		"no sx::hash specialization for this type");
+
+	size_t operator()(const T& value)const noexcept
+	{
+		if constexpr (is_integral_v<T> || is_enum_v<T>)
+		{
+			return static_cast<size_t>(hash_mix(static_cast<uint64_t>(value)));
+		}
+		else if constexpr (is_pointer_v<T>)
+		{
+			return static_cast<size_t>(hash_mix(reinterpret_cast<uintptr_t>(value)));
+		}
+		else if constexpr (sizeof(T) == sizeof(uint64_t) || sizeof(T) == sizeof(uint32_t))
+		{
+			// +0.0 与 -0.0 相等，哈希值也必须相同
+			if (value == T()) return static_cast<size_t>(hash_mix(0));
+			using bits_type = std::conditional_t<sizeof(T) == sizeof(uint64_t), uint64_t, uint32_t>;
+			return static_cast<size_t>(hash_mix(std::bit_cast<bits_type>(value)));
+		}
+		else
+		{
+			// long double 含有未使用的填充字节，转换为 double 后计算
+			return hash<double>()(static_cast<double>(value));
+		}
+	}
+};
+
+// 字符串，string 与 string_view 的哈希值相同，可用于异构查找
+template<>
+struct hash<std::string_view>
+{
+	using is_transparent = void;
+
+	size_t operator()(std::string_view s)const noexcept
+	{
+		return static_cast<size_t>(hash_bytes(s.data(), s.size()));
+	}
+};
+
+template<>
+struct hash<std::string> : hash<std::string_view> {};
+
+template<class T1, class T2>
+struct hash<pair<T1, T2>>
+{
+	size_t operator()(const pair<T1, T2>& p)const noexcept
+	{
+		return hash_combine(hash<T1>()(p.first), hash<T2>()(p.second));
+	}
+};
+
+SX_NAMESPACE_END
+#endif	// end define _SX_HASH_H_
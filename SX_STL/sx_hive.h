@@ -0,0 +1,464 @@
+﻿/**************************************************
+ * @brief   : 元素地址稳定的桶式容器 hive
+ * @file    : sx_hive.h
+ * @author  : 宋旭
+ * @date    : 2026年10月18日，23:24:51
+ **************************************************/
+
+#ifndef _SX_HIVE_H_
+#define _SX_HIVE_H_
+#include <cstdint>			// uint16_t
+#include <new>				// operator new, align_val_t
+#include <stdexcept>		// invalid_argument
+#include <type_traits>		// conditional_t
+#include <utility>			// forward, move, swap
+#include "sx_iterator.h"
+
+SX_NAMESPACE_BEGIN
+
+template<class T>
+class hive;
+
+/**
+ * hive
+ * 元素保存在容量按指数增长的块中，插入与删除都不移动其他元素，
+ * 除被删除的元素外，指针与迭代器始终有效；元素的顺序不确定
+ *
+ * 每个块有一个跳跃计数(jump-counting)的 skipfield：
+ * 连续被删除的槽组成一个跳跃块，其首尾两个位置记录跳跃块的长度，存活的槽为 0
+ * 迭代器前进时遇到跳跃块的起点，后退时遇到跳跃块的终点，都只需一次加减即可越过，
+ * 因此遍历的开销与空洞的多少无关
+ *
+ * 每个跳跃块的第一个槽中保存块内空闲链表的前后指针，插入时取有空闲槽的块的第一个跳跃块的起点，
+ * 不需要分配内存；全部元素被删除的块释放，保留一个备用块以避免在块边界反复分配
+ */
+namespace detail {
+	constexpr uint16_t __hive_npos = UINT16_MAX;
+
+	// 未使用的槽保存空闲链表的链接
+	template<class T>
+	union __hive_slot
+	{
+		T value;
+		struct
+		{
+			uint16_t prev;
+			uint16_t next;
+		} link;
+
+		__hive_slot()noexcept {}
+		~__hive_slot() {}
+	};
+
+	template<class T>
+	struct __hive_block
+	{
+		__hive_slot<T>*	elements	= nullptr;
+		uint16_t*		skipfield	= nullptr;	// capacity + 1 个，最后一个恒为 0
+		__hive_block*	next		= nullptr;
+		__hive_block*	prev		= nullptr;
+		__hive_block*	next_free	= nullptr;	// 有空闲槽的块组成的链表
+		__hive_block*	prev_free	= nullptr;
+		uint16_t		capacity	= 0;
+		uint16_t		count		= 0;
+		uint16_t		free_head	= __hive_npos;	// 第一个跳跃块的起点
+	};
+
+	template<bool Const, class T>
+	class __hive_iterator : public iterator<bidirectional_iterator_tag, T, ptrdiff_t,
+		std::conditional_t<Const, const T*, T*>, std::conditional_t<Const, const T&, T&>>
+	{
+		template<bool, class> friend class __hive_iterator;
+		template<class> friend class sx::hive;
+
+	public:
+		using reference	= std::conditional_t<Const, const T&, T&>;
+		using pointer	= std::conditional_t<Const, const T*, T*>;
+		using self		= __hive_iterator;
+
+	private:
+		__hive_block<T>*	block	= nullptr;
+		size_t				index	= 0;
+
+		__hive_iterator(__hive_block<T>* b, size_t i)noexcept : block(b), index(i) {}
+
+	public:
+		__hive_iterator() = default;
+
+		// 非 const 迭代器可转换为 const 迭代器
+		template<bool C = Const, class = std::enable_if_t<C>>
+		__hive_iterator(const __hive_iterator<false, T>& rhs)noexcept : block(rhs.block), index(rhs.index) {}
+
+		reference operator*()const noexcept { return block->elements[index].value; }
+		pointer operator->()const noexcept { return &block->elements[index].value; }
+
+		// 越过跳跃块；到达最后一个块的末尾时停在 end()
+		self& operator++()noexcept
+		{
+			++index;
+			index += block->skipfield[index];
+			if (index == block->capacity && block->next != nullptr)
+			{
+				block = block->next;
+				index = block->skipfield[0];
+			}
+			return *this;
+		}
+
+		self operator++(int)noexcept
+		{
+			auto temp = *this;
+			++*this;
+			return temp;
+		}
+
+		self& operator--()noexcept
+		{
+			if (index == 0 || block->skipfield[index - 1] >= index)
+			{
+				// 本块中前面已没有元素(块不为空，前一个块的末尾必有元素或跳跃块的终点)
+				block = block->prev;
+				index = block->capacity;
+			}
+			--index;
+			index -= block->skipfield[index];
+			return *this;
+		}
+
+		self operator--(int)noexcept
+		{
+			auto temp = *this;
+			--*this;
+			return temp;
+		}
+
+		bool operator==(const __hive_iterator<true, T>& rhs)const noexcept { return block == rhs.block && index == rhs.index; }
+		bool operator!=(const __hive_iterator<true, T>& rhs)const noexcept { return !(*this == rhs); }
+		bool operator==(const __hive_iterator<false, T>& rhs)const noexcept { return block == rhs.block && index == rhs.index; }
+		bool operator!=(const __hive_iterator<false, T>& rhs)const noexcept { return !(*this == rhs); }
+	};
+}
+
+
+template<class T>
+class hive
+{
+public:
+	using value_type		= T;
+	using size_type			= size_t;
+	using difference_type	= ptrdiff_t;
+	using reference			= T&;
+	using const_reference	= const T&;
+	using pointer			= T*;
+	using const_pointer		= const T*;
+	using iterator			= detail::__hive_iterator<false, T>;
+	using const_iterator	= detail::__hive_iterator<true, T>;
+
+	static constexpr size_t max_block_limit = 32768;
+
+private:
+	using block = detail::__hive_block<T>;
+	using slot	= detail::__hive_slot<T>;
+	static constexpr uint16_t npos = detail::__hive_npos;
+
+	block*		first			= nullptr;
+	block*		last			= nullptr;
+	block*		free_blocks		= nullptr;	// 有空闲槽的块
+	block*		spare			= nullptr;	// 备用的空块
+	size_type	count			= 0;
+	size_type	slots			= 0;		// 所有块的容量之和
+	size_t		min_block		= 8;
+	size_t		max_block		= 8192;
+
+public:
+	hive() = default;
+
+	// 块的容量从 min_block_capacity 开始按元素总数翻倍，直到 max_block_capacity
+	hive(size_t min_block_capacity, size_t max_block_capacity)
+		: min_block(min_block_capacity), max_block(max_block_capacity)
+	{
+		if (min_block < 2 || min_block > max_block || max_block > max_block_limit)
+			throw std::invalid_argument("hive block capacity out of range");
+	}
+
+	// 委托构造使对象在复制元素前已构造完成，复制中抛出异常时由析构函数释放已复制的元素与块
+	hive(const hive& rhs) : hive(rhs.min_block, rhs.max_block)
+	{
+		for (const T& value : rhs) insert(value);
+	}
+
+	hive(hive&& rhs)noexcept { swap(rhs); }
+
+	hive& operator=(hive rhs)noexcept
+	{
+		swap(rhs);
+		return *this;
+	}
+
+	~hive()
+	{
+		clear();
+		__deallocate_block(spare);
+	}
+
+	iterator begin()noexcept { return first != nullptr ? iterator(first, first->skipfield[0]) : iterator(); }
+	const_iterator begin()const noexcept { return const_cast<hive*>(this)->begin(); }
+	iterator end()noexcept { return last != nullptr ? iterator(last, last->capacity) : iterator(); }
+	const_iterator end()const noexcept { return const_cast<hive*>(this)->end(); }
+	const_iterator cbegin()const noexcept { return begin(); }
+	const_iterator cend()const noexcept { return end(); }
+
+	SX_NODISCARD bool empty()const noexcept { return count == 0; }
+	size_type size()const noexcept { return count; }
+	size_type capacity()const noexcept { return slots; }
+
+	iterator insert(const T& value) { return emplace(value); }
+	iterator insert(T&& value) { return emplace(std::move(value)); }
+
+	template<class... Args>
+	iterator emplace(Args&&... args)
+	{
+		if (free_blocks == nullptr) __append_block();
+		block* b = free_blocks;
+		const uint16_t i = b->free_head;
+		const uint16_t next = b->elements[i].link.next;
+		try
+		{
+			::new (static_cast<void*>(&b->elements[i].value)) T(std::forward<Args>(args)...);
+		}
+		catch (...)
+		{
+			// 构造失败时可能已覆盖链接，恢复为空闲链表的表头
+			b->elements[i].link.prev = npos;
+			b->elements[i].link.next = next;
+			throw;
+		}
+		__take_slot(b, i, next);
+		++b->count;
+		++count;
+		return iterator(b, i);
+	}
+
+	// 返回下一个元素的迭代器
+	iterator erase(const_iterator pos)
+	{
+		block* b = pos.block;
+		const uint16_t i = static_cast<uint16_t>(pos.index);
+		iterator next(b, pos.index);
+		++next;
+
+		b->elements[i].value.~T();
+		--count;
+		if (--b->count == 0)
+		{
+			const bool at_back = next.block == b;
+			__remove_block(b);
+			return at_back ? end() : next;
+		}
+		__release_slot(b, i);
+		return next;
+	}
+
+	// 元素的迭代器，O(块数)
+	iterator get_iterator(const T* p)noexcept
+	{
+		for (block* b = first; b != nullptr; b = b->next)
+		{
+			const slot* s = reinterpret_cast<const slot*>(p);
+			if (s >= b->elements && s < b->elements + b->capacity)
+				return iterator(b, static_cast<size_t>(s - b->elements));
+		}
+		return end();
+	}
+
+	void clear()noexcept
+	{
+		while (first != nullptr)
+		{
+			block* b = first;
+			first = b->next;
+			for (size_t i = b->skipfield[0]; i < b->capacity; )
+			{
+				b->elements[i].value.~T();
+				++i;
+				i += b->skipfield[i];
+			}
+			__deallocate_block(b);
+		}
+		last = free_blocks = nullptr;
+		count = slots = 0;
+	}
+
+	void swap(hive& rhs)noexcept
+	{
+		using std::swap;
+		swap(first, rhs.first);
+		swap(last, rhs.last);
+		swap(free_blocks, rhs.free_blocks);
+		swap(spare, rhs.spare);
+		swap(count, rhs.count);
+		swap(slots, rhs.slots);
+		swap(min_block, rhs.min_block);
+		swap(max_block, rhs.max_block);
+	}
+
+private:
+	static void __deallocate_block(block* b)noexcept
+	{
+		if (b == nullptr) return;
+		::operator delete(static_cast<void*>(b->elements), std::align_val_t(alignof(slot)));
+		delete b;
+	}
+
+	// 新块的所有槽组成一个跳跃块
+	void __append_block()
+	{
+		block* b = spare;
+		spare = nullptr;
+		if (b == nullptr)
+		{
+			size_t cap = count < min_block ? min_block : (count > max_block ? max_block : count);
+			b = new block;
+			size_t bytes = cap * sizeof(slot) + (cap + 1) * sizeof(uint16_t);
+			try
+			{
+				b->elements = static_cast<slot*>(::operator new(bytes, std::align_val_t(alignof(slot))));
+			}
+			catch (...)
+			{
+				delete b;
+				throw;
+			}
+			b->skipfield = reinterpret_cast<uint16_t*>(b->elements + cap);
+			b->capacity = static_cast<uint16_t>(cap);
+		}
+
+		const uint16_t cap = b->capacity;
+		for (size_t i = 0; i <= cap; ++i) b->skipfield[i] = 0;
+		b->skipfield[0] = b->skipfield[cap - 1] = cap;
+		b->elements[0].link.prev = b->elements[0].link.next = npos;
+		b->free_head = 0;
+		b->count = 0;
+
+		b->next = nullptr;
+		b->prev = last;
+		if (last != nullptr) last->next = b;
+		else first = b;
+		last = b;
+		slots += cap;
+		__push_free_block(b);
+	}
+
+	void __remove_block(block* b)noexcept
+	{
+		if (b->free_head != npos) __erase_free_block(b);
+		if (b->prev != nullptr) b->prev->next = b->next;
+		else first = b->next;
+		if (b->next != nullptr) b->next->prev = b->prev;
+		else last = b->prev;
+		slots -= b->capacity;
+
+		if (spare == nullptr || spare->capacity < b->capacity) std::swap(spare, b);
+		__deallocate_block(b);
+	}
+
+	void __push_free_block(block* b)noexcept
+	{
+		b->prev_free = nullptr;
+		b->next_free = free_blocks;
+		if (free_blocks != nullptr) free_blocks->prev_free = b;
+		free_blocks = b;
+	}
+
+	void __erase_free_block(block* b)noexcept
+	{
+		if (b->prev_free != nullptr) b->prev_free->next_free = b->next_free;
+		else free_blocks = b->next_free;
+		if (b->next_free != nullptr) b->next_free->prev_free = b->prev_free;
+	}
+
+	// 块内空闲链表的操作，链表中的每一项是一个跳跃块的起点
+	static void __push_skipblock(block* b, uint16_t i)noexcept
+	{
+		b->elements[i].link.prev = npos;
+		b->elements[i].link.next = b->free_head;
+		if (b->free_head != npos) b->elements[b->free_head].link.prev = i;
+		b->free_head = i;
+	}
+
+	static void __erase_skipblock(block* b, uint16_t i)noexcept
+	{
+		uint16_t prev = b->elements[i].link.prev, next = b->elements[i].link.next;
+		if (prev != npos) b->elements[prev].link.next = next;
+		else b->free_head = next;
+		if (next != npos) b->elements[next].link.prev = prev;
+	}
+
+	// 占用第一个跳跃块的起点 i，跳跃块的起点后移一位；槽 i 中原有的链接已被元素覆盖，由调用者事先保存 next
+	void __take_slot(block* b, uint16_t i, uint16_t next)noexcept
+	{
+		uint16_t* skip = b->skipfield;
+		const uint16_t len = skip[i];
+		skip[i] = 0;
+		if (len == 1)
+		{
+			b->free_head = next;
+			if (next != npos) b->elements[next].link.prev = npos;
+		}
+		else
+		{
+			const uint16_t start = static_cast<uint16_t>(i + 1);
+			skip[start] = skip[i + len - 1] = static_cast<uint16_t>(len - 1);
+			b->elements[start].link.prev = npos;
+			b->elements[start].link.next = next;
+			if (next != npos) b->elements[next].link.prev = start;
+			b->free_head = start;
+		}
+		if (b->free_head == npos) __erase_free_block(b);
+	}
+
+	// 槽 i 变为空闲，与左右相邻的跳跃块合并
+	void __release_slot(block* b, uint16_t i)noexcept
+	{
+		const bool had_free = b->free_head != npos;
+		uint16_t* skip = b->skipfield;
+		const uint16_t left = i > 0 ? skip[i - 1] : 0;
+		const uint16_t right = skip[i + 1];
+
+		if (left == 0 && right == 0)
+		{
+			skip[i] = 1;
+			__push_skipblock(b, i);
+		}
+		else if (right == 0)
+		{
+			// 延长左边跳跃块，起点不变
+			skip[i - left] = skip[i] = static_cast<uint16_t>(left + 1);
+		}
+		else if (left == 0)
+		{
+			// 与右边的跳跃块合并，起点移到 i
+			const uint16_t end = static_cast<uint16_t>(i + right);
+			__erase_skipblock(b, static_cast<uint16_t>(i + 1));
+			skip[i] = skip[end] = static_cast<uint16_t>(right + 1);
+			__push_skipblock(b, i);
+		}
+		else
+		{
+			const uint16_t start = static_cast<uint16_t>(i - left), end = static_cast<uint16_t>(i + right);
+			__erase_skipblock(b, static_cast<uint16_t>(i + 1));
+			skip[start] = skip[end] = static_cast<uint16_t>(end - start + 1);
+			skip[i] = 1;
+		}
+		if (!had_free) __push_free_block(b);
+	}
+};
+
+template<class T>
+inline void swap(hive<T>& lhs, hive<T>& rhs)noexcept
+{
+	lhs.swap(rhs);
+}
+
+SX_NAMESPACE_END
+#endif	// end define _SX_HIVE_H_
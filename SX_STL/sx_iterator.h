@@ -7,6 +7,7 @@
 
 #ifndef _SX_ITERATOR_H_
 #define _SX_ITERATOR_H_
+#include <iterator>			// std 的迭代器类型
 #include <type_traits>		// is_constructible
 #include "sx_type_traits.h"
 
@@ -15,7 +16,7 @@ SX_NAMESPACE_BEGIN
 // 五种迭代器类型
 struct input_iterator_tag {};
 struct output_iterator_tag {};
-struct forward_iterator_tag : output_iterator_tag {};
+struct forward_iterator_tag : input_iterator_tag {};
 struct bidirectional_iterator_tag : forward_iterator_tag {};
 struct random_access_iterator_tag : bidirectional_iterator_tag {};
 
@@ -44,13 +45,40 @@ namespace detail {
 		static constexpr bool value = sizeof(test<T>(nullptr)) == sizeof(char);
 	};
 
+	// 将 std 的迭代器类型转换为对应的 sx 迭代器类型，sx 的迭代器类型保持不变
+	template<class Category>
+	struct __to_sx_iterator_category : type_identity<Category> {};
+
+	template<>
+	struct __to_sx_iterator_category<std::input_iterator_tag> : type_identity<input_iterator_tag> {};
+
+	template<>
+	struct __to_sx_iterator_category<std::output_iterator_tag> : type_identity<output_iterator_tag> {};
+
+	template<>
+	struct __to_sx_iterator_category<std::forward_iterator_tag> : type_identity<forward_iterator_tag> {};
+
+	template<>
+	struct __to_sx_iterator_category<std::bidirectional_iterator_tag> : type_identity<bidirectional_iterator_tag> {};
+
+	template<>
+	struct __to_sx_iterator_category<std::random_access_iterator_tag> : type_identity<random_access_iterator_tag> {};
+
+#ifdef __cpp_lib_ranges
+	template<>
+	struct __to_sx_iterator_category<std::contiguous_iterator_tag> : type_identity<random_access_iterator_tag> {};
+#endif // __cpp_lib_ranges
+
+	template<class Category>
+	using __to_sx_iterator_category_t = typename __to_sx_iterator_category<Category>::type;
+
 	template<class Iterator, bool>
 	struct __iterator_traits_impl {};
 
 	template<class Iterator>
 	struct __iterator_traits_impl<Iterator, true>
 	{
-		using iterator_category = typename Iterator::iterator_category;
+		using iterator_category = __to_sx_iterator_category_t<typename Iterator::iterator_category>;
 		using value_type		= typename Iterator::value_type;
 		using difference_type	= typename Iterator::difference_type;
 		using pointer			= typename Iterator::pointer;
@@ -64,12 +92,13 @@ namespace detail {
 
 	template<class Iterator>
 	struct __iterator_traits_helper<Iterator, true> : __iterator_traits_impl<Iterator,
-		std::is_convertible_v<Iterator, input_iterator_tag> ||
-		std::is_convertible_v<Iterator, output_iterator_tag>> {};
+		std::is_convertible_v<__to_sx_iterator_category_t<typename Iterator::iterator_category>, input_iterator_tag> ||
+		std::is_convertible_v<__to_sx_iterator_category_t<typename Iterator::iterator_category>, output_iterator_tag>> {};
 }
 
 
 // 萃取迭代器的某种类型
+// 对于标准库容器的迭代器，iterator_category 被转换为对应的 sx 迭代器类型
 template<class Iterator>
 struct iterator_traits : detail::__iterator_traits_helper<Iterator, 
 	detail::__has_iterator_category<Iterator>::value> {};
@@ -203,7 +232,7 @@ void advance(InputIterator& iter, Distance n)
  * 最后给出一个判断是否符合标准的迭代器
  */
 template<class T, class U, bool b = detail::__has_iterator_category<iterator_traits<T>>::value>
-struct has_iterator_category_of : sx_bool_constant_t<std::is_convertible_v<iterator_traits<T>, U>> {};
+struct has_iterator_category_of : sx_bool_constant_t<std::is_convertible_v<typename iterator_traits<T>::iterator_category, U>> {};
 
 template<class T, class U>
 struct has_iterator_category_of<T, U, false> : sx_false_type {};
@@ -249,7 +278,7 @@ public:
 	using const_reference	= const reference;
 
 	using iterator_type		= Iterator;
-	using reverse_iterator<iterator_type> = self;
+	using self				= reverse_iterator<iterator_type>;
 
 public:
 	reverse_iterator() {}
@@ -279,7 +308,7 @@ public:
 	self& operator++()
 	{
 		--current;
-		reutrn* this;
+		return *this;
 	}
 
 	self operator++(int)
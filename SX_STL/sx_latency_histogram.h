@@ -0,0 +1,387 @@
+﻿/**************************************************
+ * @brief   : HDR 风格的延迟直方图与作用域计时
+ * @file    : sx_latency_histogram.h
+ * @author  : 宋旭
+ * @date    : 2026年10月19日，02:03:11
+ **************************************************/
+
+#ifndef _SX_LATENCY_HISTOGRAM_H_
+#define _SX_LATENCY_HISTOGRAM_H_
+#include <algorithm>		// lower_bound, binary_search, remove_if
+#include <atomic>			// atomic
+#include <bit>				// bit_width
+#include <chrono>			// steady_clock
+#include <cstdint>			// uint64_t
+#include <deque>			// deque
+#include <memory>			// unique_ptr
+#include <mutex>			// mutex, lock_guard
+#include <string>			// string
+#include <string_view>		// string_view
+#include <utility>			// pair
+#include <vector>			// vector
+#include "sx_def.h"
+
+SX_NAMESPACE_BEGIN
+
+/**
+ * latency_histogram
+ * 记录以纳秒为单位的耗时，桶按对数-线性划分：
+ * 小于 64 的值每个值一个桶，之后每个 2 的幂区间再线性分为 64 个桶，相对误差不超过 1/64
+ * 可记录的最大值为 2^40 - 1 纳秒(约 18 分钟)，更大的值计入最后一个桶
+ *
+ * record 不加锁：每个线程第一次记录时为其分配一份独立的计数(shard)，此后只有该线程写入，
+ * 计数为 relaxed 的原子变量，snapshot 可以在记录的同时进行，得到的是近似一致的结果
+ * shard 随直方图析构释放，线程退出后其计数仍然保留
+ * 每个线程缓存 直方图 -> shard 的对应关系，遇到新的直方图时清除已析构的直方图的项，
+ * 因此缓存的大小不超过该线程记录过的存活直方图的个数
+ *
+ * histogram_snapshot 是某一时刻的普通计数，可以合并(+=)与相减(-=，用于求两次快照之间的区间)，
+ * 并计算百分位数
+ */
+namespace detail {
+	constexpr unsigned __hist_sub_bits		= 6;
+	constexpr uint64_t __hist_sub_count		= uint64_t(1) << __hist_sub_bits;
+	constexpr unsigned __hist_max_bits		= 40;
+	constexpr uint64_t __hist_max_value		= (uint64_t(1) << __hist_max_bits) - 1;
+	constexpr size_t __hist_bucket_count	= (__hist_max_bits + 1 - __hist_sub_bits) * __hist_sub_count;
+
+	inline size_t __hist_bucket_of(uint64_t v)noexcept
+	{
+		if (v > __hist_max_value) v = __hist_max_value;
+		if (v < __hist_sub_count) return static_cast<size_t>(v);
+		const unsigned shift = static_cast<unsigned>(std::bit_width(v)) - (__hist_sub_bits + 1);
+		return static_cast<size_t>((shift + 1) * __hist_sub_count + (v >> shift) - __hist_sub_count);
+	}
+
+	// 桶中的最大值
+	inline uint64_t __hist_bucket_high(size_t i)noexcept
+	{
+		if (i < __hist_sub_count) return i;
+		const unsigned shift = static_cast<unsigned>(i / __hist_sub_count - 1);
+		const uint64_t sub = i % __hist_sub_count + __hist_sub_count;
+		return (sub << shift) + ((uint64_t(1) << shift) - 1);
+	}
+
+	// 某个线程在某个直方图中的计数
+	struct __hist_shard
+	{
+		std::atomic<uint64_t>	counts[__hist_bucket_count] = {};
+		std::atomic<uint64_t>	total{ 0 };
+		std::atomic<uint64_t>	sum{ 0 };
+		std::atomic<uint64_t>	low{ UINT64_MAX };
+		std::atomic<uint64_t>	high{ 0 };
+		__hist_shard*			next = nullptr;
+
+		// 只有所属线程写入，读-改-写不需要原子指令
+		static void bump(std::atomic<uint64_t>& a, uint64_t n)noexcept
+		{
+			a.store(a.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+		}
+	};
+
+	// 存活的直方图 id，按升序分配且不重复使用
+	struct __hist_registry
+	{
+		std::mutex				lock;
+		std::vector<uint64_t>	live;
+		uint64_t				next_id = 1;
+		std::atomic<uint64_t>	removed{ 0 };	// 已析构的直方图个数，线程缓存据此判断是否需要清理
+
+		// 不析构：静态存储期的直方图可能在登记表之后析构
+		static __hist_registry& instance()
+		{
+			static __hist_registry* registry = new __hist_registry;
+			return *registry;
+		}
+
+		uint64_t add()
+		{
+			std::lock_guard<std::mutex> g(lock);
+			live.push_back(next_id);
+			return next_id++;
+		}
+
+		void remove(uint64_t id)
+		{
+			{
+				std::lock_guard<std::mutex> g(lock);
+				live.erase(std::lower_bound(live.begin(), live.end(), id));
+			}
+			removed.fetch_add(1, std::memory_order_release);
+		}
+	};
+
+	/**
+	 * 线程局部的 直方图 id -> shard 缓存
+	 * 已析构的直方图的 shard 已被释放，它们的项不会再被命中(id 不会重复使用)，
+	 * 但会一直占用空间并拖慢查找，因此未命中时若有直方图析构过，先清除这些项
+	 */
+	struct __hist_thread_cache
+	{
+		uint64_t										last_id	= 0;
+		__hist_shard*									last	= nullptr;
+		uint64_t										pruned	= 0;	// 上次清理时的 removed
+		std::vector<std::pair<uint64_t, __hist_shard*>>	entries;
+
+		static __hist_thread_cache& local()
+		{
+			thread_local __hist_thread_cache cache;
+			return cache;
+		}
+
+		__hist_shard* find(uint64_t id)
+		{
+			if (last_id == id) return last;
+			for (const auto& entry : entries)
+			{
+				if (entry.first == id)
+				{
+					last_id = id;
+					last = entry.second;
+					return last;
+				}
+			}
+			return nullptr;
+		}
+
+		void add(uint64_t id, __hist_shard* s)
+		{
+			__hist_registry& registry = __hist_registry::instance();
+			const uint64_t removed = registry.removed.load(std::memory_order_acquire);
+			if (removed != pruned)
+			{
+				std::lock_guard<std::mutex> g(registry.lock);
+				auto dead = [&](const std::pair<uint64_t, __hist_shard*>& entry) {
+					return !std::binary_search(registry.live.begin(), registry.live.end(), entry.first);
+				};
+				entries.erase(std::remove_if(entries.begin(), entries.end(), dead), entries.end());
+				pruned = removed;
+			}
+			entries.emplace_back(id, s);
+			last_id = id;
+			last = s;
+		}
+	};
+}
+
+
+class histogram_snapshot
+{
+	friend class latency_histogram;
+
+private:
+	std::vector<uint64_t>	counts;
+	uint64_t				total	= 0;
+	uint64_t				sum		= 0;
+	uint64_t				low		= UINT64_MAX;
+	uint64_t				high	= 0;
+
+public:
+	histogram_snapshot() : counts(detail::__hist_bucket_count, 0) {}
+
+	uint64_t count()const noexcept { return total; }
+	SX_NODISCARD bool empty()const noexcept { return total == 0; }
+
+	uint64_t min()const noexcept { return total == 0 ? 0 : low; }
+	uint64_t max()const noexcept { return high; }
+	double mean()const noexcept { return total == 0 ? 0.0 : static_cast<double>(sum) / static_cast<double>(total); }
+
+	// p 取 [0, 100]，返回不小于 p% 的记录值所在桶的上界，不超过 max()
+	uint64_t percentile(double p)const noexcept
+	{
+		if (total == 0) return 0;
+		if (p <= 0.0) return min();
+		if (p > 100.0) p = 100.0;
+		uint64_t rank = static_cast<uint64_t>(p / 100.0 * static_cast<double>(total) + 0.5);
+		if (rank == 0) rank = 1;
+		if (rank > total) rank = total;
+
+		uint64_t seen = 0;
+		for (size_t i = 0; i < counts.size(); ++i)
+		{
+			seen += counts[i];
+			if (seen >= rank)
+			{
+				uint64_t v = detail::__hist_bucket_high(i);
+				return v < high ? v : high;
+			}
+		}
+		return high;
+	}
+
+	histogram_snapshot& operator+=(const histogram_snapshot& rhs)noexcept
+	{
+		for (size_t i = 0; i < counts.size(); ++i) counts[i] += rhs.counts[i];
+		total += rhs.total;
+		sum += rhs.sum;
+		if (rhs.low < low) low = rhs.low;
+		if (rhs.high > high) high = rhs.high;
+		return *this;
+	}
+
+	// 减去较早的快照得到两次快照之间的记录，min 与 max 保持为整个区间的值
+	histogram_snapshot& operator-=(const histogram_snapshot& earlier)noexcept
+	{
+		for (size_t i = 0; i < counts.size(); ++i) counts[i] -= earlier.counts[i];
+		total -= earlier.total;
+		sum -= earlier.sum;
+		return *this;
+	}
+
+	// 第 i 个桶的上界与计数，用于导出
+	size_t bucket_count()const noexcept { return counts.size(); }
+	uint64_t bucket_high(size_t i)const noexcept { return detail::__hist_bucket_high(i); }
+	uint64_t bucket_value(size_t i)const noexcept { return counts[i]; }
+};
+
+inline histogram_snapshot operator+(histogram_snapshot lhs, const histogram_snapshot& rhs)
+{
+	lhs += rhs;
+	return lhs;
+}
+
+
+class latency_histogram
+{
+private:
+	using shard = detail::__hist_shard;
+
+	const uint64_t		id;
+	std::atomic<shard*>	shards{ nullptr };
+
+public:
+	latency_histogram() : id(detail::__hist_registry::instance().add()) {}
+
+	latency_histogram(const latency_histogram&) = delete;
+	latency_histogram& operator=(const latency_histogram&) = delete;
+
+	// 析构时不能有其他线程在记录
+	~latency_histogram()
+	{
+		detail::__hist_registry::instance().remove(id);
+		shard* s = shards.load(std::memory_order_acquire);
+		while (s != nullptr)
+		{
+			shard* next = s->next;
+			delete s;
+			s = next;
+		}
+	}
+
+	void record(uint64_t nanoseconds, uint64_t times = 1)
+	{
+		shard& s = __local_shard();
+		shard::bump(s.counts[detail::__hist_bucket_of(nanoseconds)], times);
+		shard::bump(s.total, times);
+		shard::bump(s.sum, nanoseconds * times);
+		if (nanoseconds < s.low.load(std::memory_order_relaxed)) s.low.store(nanoseconds, std::memory_order_relaxed);
+		if (nanoseconds > s.high.load(std::memory_order_relaxed)) s.high.store(nanoseconds, std::memory_order_relaxed);
+	}
+
+	template<class Rep, class Period>
+	void record(std::chrono::duration<Rep, Period> d)
+	{
+		auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+		record(ns < 0 ? 0 : static_cast<uint64_t>(ns));
+	}
+
+	histogram_snapshot snapshot()const
+	{
+		histogram_snapshot snap;
+		for (shard* s = shards.load(std::memory_order_acquire); s != nullptr; s = s->next)
+		{
+			for (size_t i = 0; i < detail::__hist_bucket_count; ++i)
+				snap.counts[i] += s->counts[i].load(std::memory_order_relaxed);
+			snap.total += s->total.load(std::memory_order_relaxed);
+			snap.sum += s->sum.load(std::memory_order_relaxed);
+			uint64_t low = s->low.load(std::memory_order_relaxed);
+			uint64_t high = s->high.load(std::memory_order_relaxed);
+			if (low < snap.low) snap.low = low;
+			if (high > snap.high) snap.high = high;
+		}
+		return snap;
+	}
+
+private:
+	// 本线程的 shard，首次记录时创建
+	shard& __local_shard()
+	{
+		detail::__hist_thread_cache& cache = detail::__hist_thread_cache::local();
+		if (shard* s = cache.find(id)) return *s;
+
+		shard* s = new shard;
+		s->next = shards.load(std::memory_order_relaxed);
+		while (!shards.compare_exchange_weak(s->next, s, std::memory_order_release, std::memory_order_relaxed)) {}
+		cache.add(id, s);
+		return *s;
+	}
+};
+
+
+/**
+ * scoped_timer
+ * 构造时开始计时，析构时将耗时记录到直方图
+ */
+class scoped_timer
+{
+private:
+	latency_histogram&						hist;
+	std::chrono::steady_clock::time_point	start;
+
+public:
+	explicit scoped_timer(latency_histogram& h)noexcept : hist(h), start(std::chrono::steady_clock::now()) {}
+
+	scoped_timer(const scoped_timer&) = delete;
+	scoped_timer& operator=(const scoped_timer&) = delete;
+
+	~scoped_timer()
+	{
+		hist.record(std::chrono::steady_clock::now() - start);
+	}
+};
+
+
+/**
+ * 按名字注册的全局直方图，供 SX_SCOPED_TIMER 使用
+ * trace_histogram	-- 取得(不存在时创建)名为 name 的直方图，引用在程序结束前一直有效
+ * trace_report		-- 所有已注册直方图的名字与快照，按注册顺序
+ */
+namespace detail {
+	struct __trace_registry
+	{
+		std::mutex														mtx;
+		std::deque<std::pair<std::string, std::unique_ptr<latency_histogram>>>	entries;
+
+		// 不析构，避免其他静态对象析构时仍在记录
+		static __trace_registry& instance()
+		{
+			static __trace_registry* registry = new __trace_registry;
+			return *registry;
+		}
+	};
+}
+
+inline latency_histogram& trace_histogram(std::string_view name)
+{
+	detail::__trace_registry& r = detail::__trace_registry::instance();
+	std::lock_guard<std::mutex> lock(r.mtx);
+	for (auto& entry : r.entries)
+	{
+		if (entry.first == name) return *entry.second;
+	}
+	r.entries.emplace_back(std::string(name), std::make_unique<latency_histogram>());
+	return *r.entries.back().second;
+}
+
+inline std::vector<std::pair<std::string, histogram_snapshot>> trace_report()
+{
+	detail::__trace_registry& r = detail::__trace_registry::instance();
+	std::lock_guard<std::mutex> lock(r.mtx);
+	std::vector<std::pair<std::string, histogram_snapshot>> report;
+	report.reserve(r.entries.size());
+	for (auto& entry : r.entries) report.emplace_back(entry.first, entry.second->snapshot());
+	return report;
+}
+
+SX_NAMESPACE_END
+#endif	// end define _SX_LATENCY_HISTOGRAM_H_
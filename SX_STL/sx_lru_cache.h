@@ -0,0 +1,420 @@
+﻿/**************************************************
+ * @brief   : 有界的 LRU 与 CLOCK 缓存
+ * @file    : sx_lru_cache.h
+ * @author  : 宋旭
+ * @date    : 2026年10月18日，22:07:40
+ **************************************************/
+
+#ifndef _SX_LRU_CACHE_H_
+#define _SX_LRU_CACHE_H_
+#include <cstdint>			// uint32_t, uint64_t
+#include <functional>		// equal_to
+#include <optional>			// optional
+#include <stdexcept>		// length_error
+#include <utility>			// move, forward
+#include <vector>			// vector
+#include "sx_hash.h"
+#include "sx_trace.h"
+#include "sx_utility.h"
+
+SX_NAMESPACE_BEGIN
+
+/**
+ * lru_cache 与 clock_cache
+ * 条目保存在连续的槽数组中，由开放寻址(线性探测)的索引表从键找到槽的下标
+ * 插入不分配节点，被淘汰或删除的槽进入空闲链表重复使用
+ *
+ * lru_cache	-- 槽之间以 32 位下标组成双向链表，命中时移到表头，严格按最近最少使用淘汰
+ * clock_cache	-- 每个槽只有一个访问位，命中时仅置位，淘汰时由指针循环扫描，
+ *				   访问位为 1 的清零后跳过，为 0 的被淘汰；命中路径不修改链表，开销更低
+ *
+ * 容量以权重计，Weigher(key, value) 返回条目的权重，默认每个条目权重为 1(即按条目数)
+ * 按字节限制时可传入返回条目字节数的函数对象
+ * 单个条目的权重超过容量时不会被缓存
+ */
+
+// 每个条目的权重为 1
+struct cache_unit_weigher
+{
+	template<class K, class V>
+	size_t operator()(const K&, const V&)const noexcept { return 1; }
+};
+
+// 命中，未命中与淘汰的计数
+struct cache_stats
+{
+	uint64_t hits		= 0;
+	uint64_t misses		= 0;
+	uint64_t evictions	= 0;
+};
+
+namespace detail {
+	constexpr uint32_t __cache_npos = UINT32_MAX;
+
+	template<class K, class V, class Links>
+	struct __cache_slot : Links
+	{
+		std::optional<pair<K, V>>	entry;
+		size_t						hash	= 0;
+		size_t						weight	= 0;
+	};
+
+	/**
+	 * lru_cache 与 clock_cache 的公共实现
+	 * Derived 需提供 __on_insert(i), __on_access(i), __on_erase(i), __on_clear(), __victim(protect)
+	 */
+	template<class Derived, class K, class V, class Hash, class KeyEqual, class Weigher, class Links>
+	class __cache_base
+	{
+	public:
+		using key_type		= K;
+		using mapped_type	= V;
+		using value_type	= pair<K, V>;
+		using size_type		= size_t;
+		using hasher		= Hash;
+		using key_equal		= KeyEqual;
+
+	protected:
+		using slot_type = __cache_slot<K, V, Links>;
+
+		std::vector<slot_type>	slots;
+		std::vector<uint32_t>	free_slots;
+		std::vector<uint32_t>	index;			// 槽下标 + 1，0 表示空位，大小为 2 的幂
+		size_type				count		= 0;
+		size_type				total		= 0;	// 所有条目的权重之和
+		cache_stats				counters;
+
+		// 哈希函数，键比较函数与权重函数为空类型时与容量共用存储，不额外占用空间
+		compressed_pair<compressed_pair<Hash, KeyEqual>, compressed_pair<Weigher, size_type>> functions_limit;
+
+		const Hash& __hash()const noexcept { return functions_limit.first().first(); }
+		const KeyEqual& __key_eq()const noexcept { return functions_limit.first().second(); }
+		const Weigher& __weigher()const noexcept { return functions_limit.second().first(); }
+		size_type& __limit()noexcept { return functions_limit.second().second(); }
+		const size_type& __limit()const noexcept { return functions_limit.second().second(); }
+
+	public:
+		explicit __cache_base(size_type capacity, const Weigher& w = Weigher(), const Hash& h = Hash(), const KeyEqual& eq = KeyEqual())
+			: functions_limit(piecewise_construct, sx::forward_as_tuple(h, eq), sx::forward_as_tuple(w, capacity)) {}
+
+		SX_NODISCARD bool empty()const noexcept { return count == 0; }
+		size_type size()const noexcept { return count; }
+		size_type weight()const noexcept { return total; }
+		size_type capacity()const noexcept { return __limit(); }
+
+		const cache_stats& stats()const noexcept { return counters; }
+		void reset_stats()noexcept { counters = cache_stats(); }
+
+		// 查找并更新访问记录，未命中时返回 nullptr
+		V* get(const K& key)
+		{
+			uint32_t i = __find(key);
+			if (i == __cache_npos)
+			{
+				++counters.misses;
+				return nullptr;
+			}
+			++counters.hits;
+			__self().__on_access(i);
+			return &slots[i].entry->second;
+		}
+
+		// 查找但不更新访问记录和计数
+		const V* peek(const K& key)const
+		{
+			uint32_t i = __find(key);
+			return i == __cache_npos ? nullptr : &slots[i].entry->second;
+		}
+
+		bool contains(const K& key)const { return __find(key) != __cache_npos; }
+
+		/**
+		 * 插入或替换，必要时淘汰其他条目
+		 * 条目的权重超过容量时不缓存(已有的同键条目也被删除)，返回 false
+		 * value 可以引用缓存中的值(例如 put(k2, *get(k1)))：淘汰与移动槽之前先将其移入局部变量
+		 */
+		template<class KK, class VV>
+		bool put(KK&& key, VV&& value)
+		{
+			const size_type w = __weigher()(key, value);
+			const size_t h = __hash()(key);
+			uint32_t i = __find(key, h);
+			if (w > __limit())
+			{
+				if (i != __cache_npos) __remove(i);
+				return false;
+			}
+
+			V local(std::forward<VV>(value));
+			if (i != __cache_npos)
+			{
+				total -= slots[i].weight;
+				__evict(w, i);
+				slots[i].entry->second = std::move(local);
+				slots[i].weight = w;
+				total += w;
+				__self().__on_access(i);
+				return true;
+			}
+
+			__evict(w, __cache_npos);
+			i = __allocate_slot();
+			slot_type& s = slots[i];
+			s.entry.emplace(std::forward<KK>(key), std::move(local));
+			s.hash = h;
+			s.weight = w;
+			total += w;
+			++count;
+			__index_insert(i);
+			__self().__on_insert(i);
+			return true;
+		}
+
+		bool erase(const K& key)
+		{
+			uint32_t i = __find(key);
+			if (i == __cache_npos) return false;
+			__remove(i);
+			return true;
+		}
+
+		// 修改容量，超出部分立即淘汰
+		void set_capacity(size_type capacity)
+		{
+			__limit() = capacity;
+			__evict(0, __cache_npos);
+		}
+
+		void clear()noexcept
+		{
+			slots.clear();
+			free_slots.clear();
+			index.assign(index.size(), 0);
+			count = 0;
+			total = 0;
+			__self().__on_clear();
+		}
+
+	protected:
+		Derived& __self()noexcept { return static_cast<Derived&>(*this); }
+
+		bool __occupied(uint32_t i)const noexcept { return slots[i].entry.has_value(); }
+
+		uint32_t __find(const K& key)const
+		{
+			return __find(key, __hash()(key));
+		}
+
+		uint32_t __find(const K& key, size_t h)const
+		{
+			if (count == 0) return __cache_npos;
+			const size_t mask = index.size() - 1;
+			for (size_t pos = h & mask; ; pos = (pos + 1) & mask)
+			{
+				uint32_t e = index[pos];
+				if (e == 0) return __cache_npos;
+				const slot_type& s = slots[e - 1];
+				if (s.hash == h && __key_eq()(s.entry->first, key)) return e - 1;
+			}
+		}
+
+		// 淘汰条目，直到再加入权重 w 后不超过容量，protect 指向的槽不被淘汰
+		void __evict(size_type w, uint32_t protect)
+		{
+			while (total + w > __limit() && count > (protect == __cache_npos ? 0 : 1))
+			{
+				__remove(__self().__victim(protect));
+				++counters.evictions;
+			}
+		}
+
+		uint32_t __allocate_slot()
+		{
+			if (!free_slots.empty())
+			{
+				uint32_t i = free_slots.back();
+				free_slots.pop_back();
+				return i;
+			}
+			if (slots.size() >= __cache_npos)
+				throw std::length_error("cache has too many entries");
+			slots.emplace_back();
+			return static_cast<uint32_t>(slots.size() - 1);
+		}
+
+		void __remove(uint32_t i)
+		{
+			__self().__on_erase(i);
+			__index_erase(i);
+			slot_type& s = slots[i];
+			total -= s.weight;
+			s.entry.reset();
+			--count;
+			free_slots.push_back(i);
+		}
+
+		// 装载因子不超过 1/2，保证探测序列较短
+		void __index_insert(uint32_t i)
+		{
+			if (count * 2 > index.size())
+			{
+				// 重建时槽 i 已被占用，一并插入
+				__rehash(index.empty() ? 16 : index.size() * 2);
+				return;
+			}
+			const size_t mask = index.size() - 1;
+			size_t pos = slots[i].hash & mask;
+			while (index[pos] != 0) pos = (pos + 1) & mask;
+			index[pos] = i + 1;
+		}
+
+		// 线性探测的向后移位删除，不留墓碑
+		void __index_erase(uint32_t i)
+		{
+			const size_t mask = index.size() - 1;
+			size_t pos = slots[i].hash & mask;
+			while (index[pos] != i + 1) pos = (pos + 1) & mask;
+
+			for (size_t next = (pos + 1) & mask; index[next] != 0; next = (next + 1) & mask)
+			{
+				size_t home = slots[index[next] - 1].hash & mask;
+				// home 不在 (pos, next] 之间时，next 处的元素可以移到 pos
+				if (((next - home) & mask) >= ((next - pos) & mask))
+				{
+					index[pos] = index[next];
+					pos = next;
+				}
+			}
+			index[pos] = 0;
+		}
+
+		void __rehash(size_t n)
+		{
+			SX_SCOPED_TIMER("cache::rehash");
+			index.assign(n, 0);
+			const size_t mask = n - 1;
+			for (uint32_t i = 0; i < slots.size(); ++i)
+			{
+				if (!__occupied(i)) continue;
+				size_t pos = slots[i].hash & mask;
+				while (index[pos] != 0) pos = (pos + 1) & mask;
+				index[pos] = i + 1;
+			}
+		}
+	};
+
+	struct __lru_links
+	{
+		uint32_t prev = __cache_npos;
+		uint32_t next = __cache_npos;
+	};
+
+	struct __clock_links
+	{
+		bool referenced = false;
+	};
+}
+
+
+/**
+ * lru_cache
+ */
+template<class K, class V, class Hash = hash<K>, class KeyEqual = std::equal_to<K>, class Weigher = cache_unit_weigher>
+class lru_cache : public detail::__cache_base<lru_cache<K, V, Hash, KeyEqual, Weigher>, K, V, Hash, KeyEqual, Weigher, detail::__lru_links>
+{
+private:
+	using base = detail::__cache_base<lru_cache, K, V, Hash, KeyEqual, Weigher, detail::__lru_links>;
+	friend base;
+
+	uint32_t head = detail::__cache_npos;	// 最近使用
+	uint32_t tail = detail::__cache_npos;	// 最久未使用
+
+public:
+	using base::base;
+
+private:
+	void __link_front(uint32_t i)noexcept
+	{
+		auto& s = this->slots[i];
+		s.prev = detail::__cache_npos;
+		s.next = head;
+		if (head != detail::__cache_npos) this->slots[head].prev = i;
+		head = i;
+		if (tail == detail::__cache_npos) tail = i;
+	}
+
+	void __unlink(uint32_t i)noexcept
+	{
+		auto& s = this->slots[i];
+		if (s.prev != detail::__cache_npos) this->slots[s.prev].next = s.next;
+		else head = s.next;
+		if (s.next != detail::__cache_npos) this->slots[s.next].prev = s.prev;
+		else tail = s.prev;
+	}
+
+	void __on_insert(uint32_t i)noexcept { __link_front(i); }
+
+	void __on_access(uint32_t i)noexcept
+	{
+		if (head == i) return;
+		__unlink(i);
+		__link_front(i);
+	}
+
+	void __on_erase(uint32_t i)noexcept { __unlink(i); }
+
+	void __on_clear()noexcept { head = tail = detail::__cache_npos; }
+
+	uint32_t __victim(uint32_t protect)const noexcept
+	{
+		return tail != protect ? tail : this->slots[tail].prev;
+	}
+};
+
+
+/**
+ * clock_cache
+ */
+template<class K, class V, class Hash = hash<K>, class KeyEqual = std::equal_to<K>, class Weigher = cache_unit_weigher>
+class clock_cache : public detail::__cache_base<clock_cache<K, V, Hash, KeyEqual, Weigher>, K, V, Hash, KeyEqual, Weigher, detail::__clock_links>
+{
+private:
+	using base = detail::__cache_base<clock_cache, K, V, Hash, KeyEqual, Weigher, detail::__clock_links>;
+	friend base;
+
+	uint32_t hand = 0;
+
+public:
+	using base::base;
+
+private:
+	void __on_insert(uint32_t i)noexcept { this->slots[i].referenced = false; }
+
+	// 已置位时不再写入，命中路径只读
+	void __on_access(uint32_t i)noexcept
+	{
+		if (!this->slots[i].referenced) this->slots[i].referenced = true;
+	}
+
+	void __on_erase(uint32_t)noexcept {}
+
+	void __on_clear()noexcept { hand = 0; }
+
+	// 至多扫描两圈：第一圈清除访问位，第二圈必然找到访问位为 0 的槽
+	uint32_t __victim(uint32_t protect)noexcept
+	{
+		const uint32_t n = static_cast<uint32_t>(this->slots.size());
+		for (;;)
+		{
+			if (hand >= n) hand = 0;
+			uint32_t i = hand++;
+			if (i == protect || !this->__occupied(i)) continue;
+			auto& s = this->slots[i];
+			if (!s.referenced) return i;
+			s.referenced = false;
+		}
+	}
+};
+
+SX_NAMESPACE_END
+#endif	// end define _SX_LRU_CACHE_H_
@@ -0,0 +1,432 @@
+﻿/**************************************************
+ * @brief   : 以文件映射(mmap)为存储的持久化 vector
+ * @file    : sx_mmap_vector.h
+ * @author  : 宋旭
+ * @date    : 2026年10月18日，16:02:41
+ **************************************************/
+
+#ifndef _SX_MMAP_VECTOR_H_
+#define _SX_MMAP_VECTOR_H_
+#include <cerrno>			// errno
+#include <cstdint>			// uint64_t
+#include <cstring>			// memcpy, memcmp
+#include <system_error>		// system_error
+#include <stdexcept>		// out_of_range, logic_error
+#include <fcntl.h>			// open
+#include <unistd.h>			// ftruncate, close, sysconf
+#include <sys/mman.h>		// mmap, mremap, madvise, msync
+#include <sys/stat.h>		// fstat
+#include "sx_type_traits.h"
+#include "sx_iterator.h"
+#include "sx_trace.h"
+
+SX_NAMESPACE_BEGIN
+
+// 打开文件的方式
+enum class mmap_open_mode
+{
+	read_only,			// 只读打开已存在的文件
+	read_write,			// 读写打开已存在的文件
+	open_or_create,		// 文件不存在则创建
+	create_truncate		// 总是创建新文件，清除原有内容
+};
+
+// 传给 madvise 的访问模式提示
+enum class mmap_advice
+{
+	normal,				// MADV_NORMAL
+	sequential,			// MADV_SEQUENTIAL
+	random,				// MADV_RANDOM
+	willneed,			// MADV_WILLNEED
+	dontneed			// MADV_DONTNEED
+};
+
+
+namespace detail {
+	// 文件头，位于文件起始处，数据紧随其后
+	// 大小固定为 64 字节，使数据区按缓存行对齐
+	struct __mmap_vector_header
+	{
+		char		magic[8];
+		uint64_t	element_size;
+		uint64_t	size;
+		uint64_t	reserved[5];
+	};
+
+	static_assert(sizeof(__mmap_vector_header) == 64, "mmap_vector header must be 64 bytes");
+
+	constexpr char __mmap_vector_magic[8] = { 'S', 'X', 'M', 'V', 'E', 'C', '0', '1' };
+
+	inline int __to_madvise_flag(mmap_advice advice)
+	{
+		switch (advice)
+		{
+		case mmap_advice::sequential:	return MADV_SEQUENTIAL;
+		case mmap_advice::random:		return MADV_RANDOM;
+		case mmap_advice::willneed:		return MADV_WILLNEED;
+		case mmap_advice::dontneed:		return MADV_DONTNEED;
+		default:						return MADV_NORMAL;
+		}
+	}
+
+	SX_NORETURN inline void __throw_mmap_error(const char* what)
+	{
+		throw std::system_error(errno, std::generic_category(), what);
+	}
+}
+
+
+/**
+ * mmap_vector
+ * 元素存放在被映射的文件中，进程重启后直接映射即可使用，无需反序列化
+ * 多个进程映射同一文件时共享操作系统的页缓存
+ * 仅支持可平凡复制的类型，元素按原始内存写入文件
+ * 迭代器即原生指针，可直接使用 iterator_traits<T*>
+ */
+template<class T>
+class mmap_vector
+{
+	static_assert(is_trivially_copyable_v<T>, "mmap_vector requires a trivially copyable type");
+	static_assert(alignof(T) <= sizeof(detail::__mmap_vector_header), "mmap_vector element alignment is too large");
+
+public:
+	using value_type		= T;
+	using size_type			= size_t;
+	using difference_type	= ptrdiff_t;
+	using pointer			= T*;
+	using const_pointer		= const T*;
+	using reference			= T&;
+	using const_reference	= const T&;
+	using iterator			= T*;
+	using const_iterator	= const T*;
+
+	using self				= mmap_vector<T>;
+	using header_type		= detail::__mmap_vector_header;
+
+private:
+	int				fd			= -1;
+	void*			base		= nullptr;		// 映射起始地址(文件头)
+	size_type		map_bytes	= 0;			// 映射的字节数，等于文件大小
+	size_type		cap			= 0;			// 可容纳的元素个数
+	bool			writable	= false;
+
+public:
+	mmap_vector() = default;
+
+	explicit mmap_vector(const char* path, mmap_open_mode mode = mmap_open_mode::open_or_create)
+	{
+		open(path, mode);
+	}
+
+	mmap_vector(const self&) = delete;
+	self& operator=(const self&) = delete;
+
+	mmap_vector(self&& rhs)noexcept
+		: fd(rhs.fd), base(rhs.base), map_bytes(rhs.map_bytes), cap(rhs.cap), writable(rhs.writable)
+	{
+		rhs.fd = -1;
+		rhs.base = nullptr;
+		rhs.map_bytes = 0;
+		rhs.cap = 0;
+	}
+
+	self& operator=(self&& rhs)noexcept
+	{
+		if (this != &rhs)
+		{
+			close();
+			fd = rhs.fd;
+			base = rhs.base;
+			map_bytes = rhs.map_bytes;
+			cap = rhs.cap;
+			writable = rhs.writable;
+			rhs.fd = -1;
+			rhs.base = nullptr;
+			rhs.map_bytes = 0;
+			rhs.cap = 0;
+		}
+		return *this;
+	}
+
+	~mmap_vector()
+	{
+		close();
+	}
+
+	// 打开并映射文件，若已打开其他文件则先关闭
+	void open(const char* path, mmap_open_mode mode = mmap_open_mode::open_or_create)
+	{
+		close();
+
+		int flags = O_RDWR;
+		if (mode == mmap_open_mode::read_only) flags = O_RDONLY;
+		else if (mode == mmap_open_mode::open_or_create) flags |= O_CREAT;
+		else if (mode == mmap_open_mode::create_truncate) flags |= O_CREAT | O_TRUNC;
+
+		fd = ::open(path, flags | O_CLOEXEC, 0644);
+		if (fd < 0) detail::__throw_mmap_error("mmap_vector: open");
+		writable = mode != mmap_open_mode::read_only;
+
+		struct stat st;
+		if (::fstat(fd, &st) != 0) __fail("mmap_vector: fstat");
+
+		size_type file_bytes = static_cast<size_type>(st.st_size);
+		if (file_bytes == 0)
+		{
+			// 新文件，写入文件头
+			if (!writable) __fail_with(EINVAL, "mmap_vector: empty file opened read-only");
+			file_bytes = sizeof(header_type);
+			if (::ftruncate(fd, static_cast<off_t>(file_bytes)) != 0) __fail("mmap_vector: ftruncate");
+			__map(file_bytes);
+			std::memcpy(header()->magic, detail::__mmap_vector_magic, sizeof(header()->magic));
+			header()->element_size = sizeof(T);
+			header()->size = 0;
+		}
+		else
+		{
+			if (file_bytes < sizeof(header_type)) __fail_with(EINVAL, "mmap_vector: file too small");
+			__map(file_bytes);
+			if (std::memcmp(header()->magic, detail::__mmap_vector_magic, sizeof(header()->magic)) != 0 ||
+				header()->element_size != sizeof(T) || header()->size > cap)
+			{
+				__fail_with(EINVAL, "mmap_vector: bad file header");
+			}
+		}
+	}
+
+	// 解除映射并关闭文件，不会自动 msync，由操作系统回写脏页
+	void close()noexcept
+	{
+		if (base != nullptr) ::munmap(base, map_bytes);
+		if (fd >= 0) ::close(fd);
+		fd = -1;
+		base = nullptr;
+		map_bytes = 0;
+		cap = 0;
+	}
+
+	bool is_open()const noexcept { return base != nullptr; }
+
+	// 迭代器相关
+	iterator begin()noexcept { return data(); }
+	const_iterator begin()const noexcept { return data(); }
+	const_iterator cbegin()const noexcept { return data(); }
+	iterator end()noexcept { return data() + size(); }
+	const_iterator end()const noexcept { return data() + size(); }
+	const_iterator cend()const noexcept { return data() + size(); }
+
+	// 容量相关
+	SX_NODISCARD bool empty()const noexcept { return size() == 0; }
+	size_type size()const noexcept { return base != nullptr ? static_cast<size_type>(header()->size) : 0; }
+	size_type capacity()const noexcept { return cap; }
+
+	// 元素访问
+	pointer data()noexcept
+	{
+		return base != nullptr ? reinterpret_cast<pointer>(static_cast<char*>(base) + sizeof(header_type)) : nullptr;
+	}
+
+	const_pointer data()const noexcept
+	{
+		return base != nullptr ? reinterpret_cast<const_pointer>(static_cast<const char*>(base) + sizeof(header_type)) : nullptr;
+	}
+
+	reference operator[](size_type n) { return data()[n]; }
+	const_reference operator[](size_type n)const { return data()[n]; }
+
+	reference at(size_type n)
+	{
+		if (n >= size()) throw std::out_of_range("mmap_vector::at");
+		return data()[n];
+	}
+
+	const_reference at(size_type n)const
+	{
+		if (n >= size()) throw std::out_of_range("mmap_vector::at");
+		return data()[n];
+	}
+
+	reference front() { return data()[0]; }
+	const_reference front()const { return data()[0]; }
+	reference back() { return data()[size() - 1]; }
+	const_reference back()const { return data()[size() - 1]; }
+
+	// 修改相关
+	void reserve(size_type n)
+	{
+		if (n > cap) __grow(n);
+	}
+
+	void push_back(const T& value)
+	{
+		size_type n = size();
+		if (n == cap)
+		{
+			// value 可能位于映射区内，重新映射前先复制一份
+			T temp = value;
+			__grow(__next_capacity(n + 1));
+			data()[n] = temp;
+		}
+		else
+		{
+			data()[n] = value;
+		}
+		header()->size = n + 1;
+	}
+
+	template<class... Args>
+	reference emplace_back(Args&&... args)
+	{
+		push_back(T(std::forward<Args>(args)...));
+		return back();
+	}
+
+	void pop_back()
+	{
+		--header()->size;
+	}
+
+	// 追加一段连续元素，按原始内存复制
+	void append(const T* first, size_type count)
+	{
+		size_type n = size();
+		if (n + count > cap)
+		{
+			// first 可能指向映射区内，记录偏移量以便重新映射后修正
+			const T* old_data = data();
+			bool inside = first >= old_data && first < old_data + n;
+			size_type offset = inside ? static_cast<size_type>(first - old_data) : 0;
+			__grow(__next_capacity(n + count));
+			if (inside) first = data() + offset;
+		}
+		std::memcpy(data() + n, first, count * sizeof(T));
+		header()->size = n + count;
+	}
+
+	void resize(size_type n, const T& value = T())
+	{
+		size_type old = size();
+		if (n > cap)
+		{
+			T temp = value;
+			__grow(n);
+			for (size_type i = old; i < n; ++i) data()[i] = temp;
+		}
+		else
+		{
+			for (size_type i = old; i < n; ++i) data()[i] = value;
+		}
+		header()->size = n;
+	}
+
+	void clear()noexcept
+	{
+		if (base != nullptr) header()->size = 0;
+	}
+
+	// 将文件截断到恰好容纳 size() 个元素
+	void shrink_to_fit()
+	{
+		if (base == nullptr) return;
+		if (!writable) throw std::logic_error("mmap_vector: container is read-only");
+		if (cap > size()) __remap(size());
+	}
+
+	// 访问模式提示，作用于整个数据区
+	void advise(mmap_advice advice)
+	{
+		if (base != nullptr && ::madvise(base, map_bytes, detail::__to_madvise_flag(advice)) != 0)
+			detail::__throw_mmap_error("mmap_vector: madvise");
+	}
+
+	// 访问模式提示，作用于 [first, first + count) 个元素所在的页
+	void advise(mmap_advice advice, size_type first, size_type count)
+	{
+		if (base == nullptr || count == 0) return;
+		const size_type page = __page_size();
+		size_type begin_byte = sizeof(header_type) + first * sizeof(T);
+		size_type end_byte = begin_byte + count * sizeof(T);
+		if (end_byte > map_bytes) end_byte = map_bytes;
+		begin_byte &= ~(page - 1);
+		if (begin_byte >= end_byte) return;
+		if (::madvise(static_cast<char*>(base) + begin_byte, end_byte - begin_byte, detail::__to_madvise_flag(advice)) != 0)
+			detail::__throw_mmap_error("mmap_vector: madvise");
+	}
+
+	// 将脏页写回文件, async 为 true 时仅发起回写而不等待
+	void flush(bool async = false)
+	{
+		if (base != nullptr && writable && ::msync(base, map_bytes, async ? MS_ASYNC : MS_SYNC) != 0)
+			detail::__throw_mmap_error("mmap_vector: msync");
+	}
+
+private:
+	header_type* header()noexcept { return static_cast<header_type*>(base); }
+	const header_type* header()const noexcept { return static_cast<const header_type*>(base); }
+
+	static size_type __page_size()noexcept
+	{
+		static const size_type page = static_cast<size_type>(::sysconf(_SC_PAGESIZE));
+		return page;
+	}
+
+	// 按页对齐增长，至少翻倍
+	size_type __next_capacity(size_type need)const noexcept
+	{
+		size_type n = cap < 16 ? 16 : cap * 2;
+		if (n < need) n = need;
+		const size_type page = __page_size();
+		size_type bytes = (sizeof(header_type) + n * sizeof(T) + page - 1) & ~(page - 1);
+		return (bytes - sizeof(header_type)) / sizeof(T);
+	}
+
+	void __map(size_type bytes)
+	{
+		int prot = writable ? PROT_READ | PROT_WRITE : PROT_READ;
+		void* p = ::mmap(nullptr, bytes, prot, MAP_SHARED, fd, 0);
+		if (p == MAP_FAILED) __fail("mmap_vector: mmap");
+		base = p;
+		map_bytes = bytes;
+		cap = (bytes - sizeof(header_type)) / sizeof(T);
+	}
+
+	void __grow(size_type n)
+	{
+		SX_SCOPED_TIMER("mmap_vector::grow");
+		if (!writable) throw std::logic_error("mmap_vector: container is read-only");
+		__remap(n);
+	}
+
+	// 调整文件大小并重新映射，映射地址可能改变
+	void __remap(size_type n)
+	{
+		size_type bytes = sizeof(header_type) + n * sizeof(T);
+		if (::ftruncate(fd, static_cast<off_t>(bytes)) != 0)
+			detail::__throw_mmap_error("mmap_vector: ftruncate");
+#ifdef MREMAP_MAYMOVE
+		void* p = ::mremap(base, map_bytes, bytes, MREMAP_MAYMOVE);
+		if (p == MAP_FAILED) detail::__throw_mmap_error("mmap_vector: mremap");
+		base = p;
+		map_bytes = bytes;
+		cap = n;
+#else
+		::munmap(base, map_bytes);
+		base = nullptr;
+		__map(bytes);
+#endif // MREMAP_MAYMOVE
+	}
+
+	SX_NORETURN void __fail(const char* what)
+	{
+		__fail_with(errno, what);
+	}
+
+	SX_NORETURN void __fail_with(int err, const char* what)
+	{
+		close();
+		throw std::system_error(err, std::generic_category(), what);
+	}
+};
+
+SX_NAMESPACE_END
+#endif	// end define _SX_MMAP_VECTOR_H_
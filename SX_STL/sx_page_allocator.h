@@ -0,0 +1,202 @@
+﻿/**************************************************
+ * @brief   : 支持大页与 NUMA 的页分配器
+ * @file    : sx_page_allocator.h
+ * @author  : 宋旭
+ * @date    : 2026年10月18日，23:59:04
+ **************************************************/
+
+#ifndef _SX_PAGE_ALLOCATOR_H_
+#define _SX_PAGE_ALLOCATOR_H_
+#include <cstdint>			// uintptr_t
+#include <new>				// bad_alloc
+#include <unistd.h>			// sysconf, syscall
+#include <sys/mman.h>		// mmap, munmap, madvise
+#include <sys/syscall.h>	// SYS_mbind, SYS_getcpu
+#include "sx_def.h"
+
+SX_NAMESPACE_BEGIN
+
+// 大页的使用方式
+enum class huge_page_policy
+{
+	none,				// 普通页
+	transparent,		// 按 2MB 对齐映射并 madvise(MADV_HUGEPAGE)，由内核的透明大页合并
+	explicit_first		// 先尝试 MAP_HUGETLB 预留的大页，失败时退回 transparent
+};
+
+/**
+ * page_allocator
+ * 直接以匿名 mmap 向系统申请整页内存，适合大块且长期存在的缓冲区(哈希表，arena 的块等)
+ * 使用大页可以大幅减少随机访问大表时的 TLB 缺失
+ *
+ * bind_local_node 为 true 时，以 mbind(MPOL_PREFERRED) 将内存优先放在调用线程所在的 NUMA 节点，
+ * 单节点机器或内核不支持时 mbind 失败，忽略错误，不影响分配
+ *
+ * 分配失败抛出 std::bad_alloc；deallocate 需传入与 allocate 相同的字节数
+ */
+namespace detail {
+	constexpr size_t __huge_page_size = size_t(2) << 20;
+
+	inline size_t __system_page_size()noexcept
+	{
+		static const size_t size = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+		return size;
+	}
+
+	inline size_t __round_up(size_t n, size_t align)noexcept
+	{
+		return (n + align - 1) & ~(align - 1);
+	}
+
+	// 调用线程当前所在的 NUMA 节点，无法取得时返回 -1
+	inline int __current_numa_node()noexcept
+	{
+#ifdef SYS_getcpu
+		unsigned cpu = 0, node = 0;
+		if (::syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) return static_cast<int>(node);
+#endif // SYS_getcpu
+		return -1;
+	}
+
+	inline void __bind_to_node(void* p, size_t bytes, int node)noexcept
+	{
+#ifdef SYS_mbind
+		constexpr int mpol_preferred = 1;
+		constexpr size_t mask_bits = sizeof(unsigned long) * 8;
+		if (node < 0 || static_cast<size_t>(node) >= mask_bits) return;
+		unsigned long mask = 1UL << node;
+		::syscall(SYS_mbind, p, bytes, mpol_preferred, &mask, mask_bits + 1, 0);
+#else
+		(void)p; (void)bytes; (void)node;
+#endif // SYS_mbind
+	}
+
+	// 映射 bytes 字节并使起始地址按 align 对齐，多映射的部分立即归还
+	inline void* __map_aligned(size_t bytes, size_t align)noexcept
+	{
+		const size_t span = bytes + align;
+		void* raw = ::mmap(nullptr, span, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (raw == MAP_FAILED) return nullptr;
+
+		uintptr_t begin = reinterpret_cast<uintptr_t>(raw);
+		uintptr_t aligned = (begin + align - 1) & ~(uintptr_t(align) - 1);
+		if (aligned > begin) ::munmap(raw, aligned - begin);
+		const size_t tail = begin + span - (aligned + bytes);
+		if (tail > 0) ::munmap(reinterpret_cast<void*>(aligned + bytes), tail);
+		return reinterpret_cast<void*>(aligned);
+	}
+}
+
+class page_allocator
+{
+private:
+	huge_page_policy	policy;
+	bool				bind_local_node;
+
+public:
+	explicit page_allocator(huge_page_policy huge = huge_page_policy::transparent, bool numa_local = false)noexcept
+		: policy(huge), bind_local_node(numa_local) {}
+
+	huge_page_policy huge_pages()const noexcept { return policy; }
+	bool numa_local()const noexcept { return bind_local_node; }
+
+	// 实际映射的字节数：按页向上取整，使用大页时按 2MB 取整
+	size_t mapped_size(size_t bytes)const noexcept
+	{
+		const size_t page = policy == huge_page_policy::none ? detail::__system_page_size() : detail::__huge_page_size;
+		return detail::__round_up(bytes == 0 ? 1 : bytes, page);
+	}
+
+	void* allocate(size_t bytes)const
+	{
+		const size_t size = mapped_size(bytes);
+		void* p = nullptr;
+
+#ifdef MAP_HUGETLB
+		if (policy == huge_page_policy::explicit_first)
+		{
+			p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+			if (p == MAP_FAILED) p = nullptr;
+		}
+#endif // MAP_HUGETLB
+
+		if (p == nullptr)
+		{
+			if (policy == huge_page_policy::none)
+			{
+				p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+				if (p == MAP_FAILED) p = nullptr;
+			}
+			else
+			{
+				// 透明大页只作用于 2MB 对齐的区域
+				p = detail::__map_aligned(size, detail::__huge_page_size);
+#ifdef MADV_HUGEPAGE
+				if (p != nullptr) ::madvise(p, size, MADV_HUGEPAGE);
+#endif // MADV_HUGEPAGE
+			}
+		}
+		if (p == nullptr) throw std::bad_alloc();
+
+		// 必须在首次访问之前绑定，页在首次写入时才真正分配
+		if (bind_local_node) detail::__bind_to_node(p, size, detail::__current_numa_node());
+		return p;
+	}
+
+	void deallocate(void* p, size_t bytes)const noexcept
+	{
+		if (p != nullptr) ::munmap(p, mapped_size(bytes));
+	}
+
+	bool operator==(const page_allocator& rhs)const noexcept
+	{
+		return policy == rhs.policy && bind_local_node == rhs.bind_local_node;
+	}
+
+	bool operator!=(const page_allocator& rhs)const noexcept { return !(*this == rhs); }
+};
+
+
+/**
+ * page_allocator_adaptor
+ * 满足标准库分配器要求，每次分配都是独立的映射，
+ * 用于 std::vector 等容器中大的连续缓冲区，例如
+ * std::vector<uint64_t, sx::page_allocator_adaptor<uint64_t>> table(n);
+ */
+template<class T>
+class page_allocator_adaptor
+{
+	template<class U> friend class page_allocator_adaptor;
+
+private:
+	page_allocator backend;
+
+public:
+	using value_type = T;
+
+	page_allocator_adaptor()noexcept = default;
+	explicit page_allocator_adaptor(const page_allocator& a)noexcept : backend(a) {}
+
+	template<class U>
+	page_allocator_adaptor(const page_allocator_adaptor<U>& rhs)noexcept : backend(rhs.backend) {}
+
+	T* allocate(size_t n)
+	{
+		if (n > SIZE_MAX / sizeof(T)) throw std::bad_alloc();
+		return static_cast<T*>(backend.allocate(n * sizeof(T)));
+	}
+
+	void deallocate(T* p, size_t n)noexcept
+	{
+		backend.deallocate(p, n * sizeof(T));
+	}
+
+	template<class U>
+	bool operator==(const page_allocator_adaptor<U>& rhs)const noexcept { return backend == rhs.backend; }
+
+	template<class U>
+	bool operator!=(const page_allocator_adaptor<U>& rhs)const noexcept { return !(*this == rhs); }
+};
+
+SX_NAMESPACE_END
+#endif	// end define _SX_PAGE_ALLOCATOR_H_
@@ -0,0 +1,531 @@
+﻿/**************************************************
+ * @brief   : 优先队列：d 叉堆，配对堆与基数堆
+ * @file    : sx_priority_queue.h
+ * @author  : 宋旭
+ * @date    : 2026年10月18日，17:48:20
+ **************************************************/
+
+#ifndef _SX_PRIORITY_QUEUE_H_
+#define _SX_PRIORITY_QUEUE_H_
+#include <cstdint>			// uint64_t
+#include <functional>		// less
+#include <stdexcept>		// out_of_range
+#include <type_traits>		// enable_if_t, make_unsigned_t
+#include <utility>			// move, forward, swap
+#include <vector>			// vector
+#include "sx_bit.h"
+#include "sx_type_traits.h"
+#include "sx_utility.h"
+
+SX_NAMESPACE_BEGIN
+
+/**
+ * priority_queue
+ * 以 D 叉堆实现的优先队列，默认 4 叉
+ * 与二叉堆相比树高减半，且同一节点的 D 个子节点位于相邻内存，
+ * 下沉时比较的元素大多落在同一缓存行内
+ * 与 std::priority_queue 相同，Compare(a, b) 为 true 表示 a 的优先级低于 b
+ */
+template<class T, class Container = std::vector<T>, class Compare = std::less<typename Container::value_type>, size_t D = 4>
+class priority_queue
+{
+	static_assert(D >= 2, "priority_queue arity must be at least 2");
+
+public:
+	using container_type	= Container;
+	using value_compare		= Compare;
+	using value_type		= typename Container::value_type;
+	using size_type			= typename Container::size_type;
+	using reference			= typename Container::reference;
+	using const_reference	= typename Container::const_reference;
+
+	static constexpr size_t arity = D;
+
+protected:
+	// 无状态的比较器不占用空间
+	compressed_pair<Compare, Container> data;
+
+	Container& __cont()noexcept { return data.second(); }
+	const Container& __cont()const noexcept { return data.second(); }
+	const Compare& __comp()const noexcept { return data.first(); }
+
+public:
+	priority_queue() = default;
+
+	explicit priority_queue(const Compare& compare, Container cont = Container())
+		: data(compare, std::move(cont))
+	{
+		__make_heap();
+	}
+
+	template<class InputIterator>
+	priority_queue(InputIterator first, InputIterator last, const Compare& compare = Compare())
+		: data(piecewise_construct, sx::forward_as_tuple(compare), sx::forward_as_tuple(first, last))
+	{
+		__make_heap();
+	}
+
+	const_reference top()const { return __cont().front(); }
+
+	SX_NODISCARD bool empty()const { return __cont().empty(); }
+	size_type size()const { return __cont().size(); }
+
+	void push(const value_type& value)
+	{
+		Container& c = __cont();
+		c.push_back(value);
+		__sift_up(c.size() - 1);
+	}
+
+	void push(value_type&& value)
+	{
+		Container& c = __cont();
+		c.push_back(std::move(value));
+		__sift_up(c.size() - 1);
+	}
+
+	template<class... Args>
+	void emplace(Args&&... args)
+	{
+		Container& c = __cont();
+		c.emplace_back(std::forward<Args>(args)...);
+		__sift_up(c.size() - 1);
+	}
+
+	void pop()
+	{
+		Container& c = __cont();
+		if (c.size() > 1)
+		{
+			value_type last = std::move(c.back());
+			c.pop_back();
+			__sift_down(0, std::move(last));
+		}
+		else
+		{
+			c.pop_back();
+		}
+	}
+
+	// 取出堆顶元素，省去一次 top() 的复制
+	value_type take()
+	{
+		Container& c = __cont();
+		value_type result = std::move(c.front());
+		pop();
+		return result;
+	}
+
+	void swap(priority_queue& rhs)noexcept
+	{
+		data.swap(rhs.data);
+	}
+
+protected:
+	static size_type __parent(size_type i)noexcept { return (i - 1) / D; }
+	static size_type __first_child(size_type i)noexcept { return i * D + 1; }
+
+	// 以 "空洞" 方式上浮，每层只移动一次元素
+	void __sift_up(size_type i)
+	{
+		Container& c = __cont();
+		const Compare& comp = __comp();
+		value_type value = std::move(c[i]);
+		while (i > 0)
+		{
+			size_type p = __parent(i);
+			if (!comp(c[p], value)) break;
+			c[i] = std::move(c[p]);
+			i = p;
+		}
+		c[i] = std::move(value);
+	}
+
+	// 将 value 放入位置 i 并下沉
+	void __sift_down(size_type i, value_type value)
+	{
+		Container& c = __cont();
+		const Compare& comp = __comp();
+		const size_type n = c.size();
+		for (;;)
+		{
+			size_type first = __first_child(i);
+			if (first >= n) break;
+			size_type last = first + D < n ? first + D : n;
+			size_type best = first;
+			for (size_type k = first + 1; k < last; ++k)
+				if (comp(c[best], c[k])) best = k;
+			if (!comp(value, c[best])) break;
+			c[i] = std::move(c[best]);
+			i = best;
+		}
+		c[i] = std::move(value);
+	}
+
+	void __make_heap()
+	{
+		Container& c = __cont();
+		const size_type n = c.size();
+		if (n < 2) return;
+		for (size_type i = __parent(n - 1) + 1; i-- > 0;)
+			__sift_down(i, std::move(c[i]));
+	}
+};
+
+
+/**
+ * pairing_heap
+ * 可寻址的配对堆，push 返回句柄，可通过句柄提升元素的优先级(decrease_key)或删除元素
+ * push / decrease_key 为 O(1)，pop 均摊 O(log n)
+ * 优先级约定与 priority_queue 相同；最短路径等需要小顶堆的场合使用 std::greater
+ */
+template<class T, class Compare = std::less<T>>
+class pairing_heap
+{
+private:
+	struct node
+	{
+		T		value;
+		node*	child	= nullptr;	// 第一个子节点
+		node*	sibling	= nullptr;	// 右兄弟
+		node*	prev	= nullptr;	// 左兄弟，若为第一个子节点则为父节点
+
+		template<class... Args>
+		explicit node(Args&&... args) : value(std::forward<Args>(args)...) {}
+	};
+
+public:
+	using value_type		= T;
+	using value_compare		= Compare;
+	using size_type			= size_t;
+	using const_reference	= const T&;
+
+	// 元素句柄，在元素被弹出或删除前一直有效
+	class handle
+	{
+		friend class pairing_heap;
+
+	private:
+		node* ptr = nullptr;
+		explicit handle(node* p)noexcept : ptr(p) {}
+
+	public:
+		handle() = default;
+
+		const T& operator*()const noexcept { return ptr->value; }
+		const T* operator->()const noexcept { return &ptr->value; }
+		explicit operator bool()const noexcept { return ptr != nullptr; }
+		bool operator==(const handle& rhs)const noexcept { return ptr == rhs.ptr; }
+		bool operator!=(const handle& rhs)const noexcept { return ptr != rhs.ptr; }
+	};
+
+private:
+	node*		root	= nullptr;
+	size_type	count	= 0;
+
+	// 比较器与 pop 时两趟合并使用的缓冲区，缓冲区重复使用避免分配
+	compressed_pair<Compare, std::vector<node*>> comp_pass;
+
+public:
+	pairing_heap() = default;
+	explicit pairing_heap(const Compare& compare) : comp_pass(compare, std::vector<node*>()) {}
+
+	pairing_heap(const pairing_heap&) = delete;
+	pairing_heap& operator=(const pairing_heap&) = delete;
+
+	pairing_heap(pairing_heap&& rhs)noexcept
+		: root(rhs.root), count(rhs.count), comp_pass(std::move(rhs.comp_pass))
+	{
+		rhs.root = nullptr;
+		rhs.count = 0;
+	}
+
+	pairing_heap& operator=(pairing_heap&& rhs)noexcept
+	{
+		if (this != &rhs)
+		{
+			clear();
+			root = rhs.root;
+			count = rhs.count;
+			comp_pass = std::move(rhs.comp_pass);
+			rhs.root = nullptr;
+			rhs.count = 0;
+		}
+		return *this;
+	}
+
+	~pairing_heap()
+	{
+		clear();
+	}
+
+	SX_NODISCARD bool empty()const noexcept { return root == nullptr; }
+	size_type size()const noexcept { return count; }
+
+	const_reference top()const { return root->value; }
+	handle top_handle()const noexcept { return handle(root); }
+
+	handle push(const T& value) { return emplace(value); }
+	handle push(T&& value) { return emplace(std::move(value)); }
+
+	template<class... Args>
+	handle emplace(Args&&... args)
+	{
+		node* p = new node(std::forward<Args>(args)...);
+		root = __meld(root, p);
+		++count;
+		return handle(p);
+	}
+
+	void pop()
+	{
+		node* old = root;
+		root = __merge_pairs(root->child);
+		if (root != nullptr) root->prev = nullptr;
+		delete old;
+		--count;
+	}
+
+	// 取出堆顶元素
+	T take()
+	{
+		T result = std::move(root->value);
+		pop();
+		return result;
+	}
+
+	/**
+	 * 将句柄所指元素的值改为 value，value 的优先级不得低于原值
+	 * 例如 pairing_heap<int, std::greater<int>> 中只能将键值减小
+	 */
+	void decrease_key(handle h, const T& value)
+	{
+		h.ptr->value = value;
+		__promote(h.ptr);
+	}
+
+	void decrease_key(handle h, T&& value)
+	{
+		h.ptr->value = std::move(value);
+		__promote(h.ptr);
+	}
+
+	// 删除句柄所指的元素
+	void erase(handle h)
+	{
+		node* p = h.ptr;
+		if (p != root)
+		{
+			__detach(p);
+			node* sub = __merge_pairs(p->child);
+			if (sub != nullptr) sub->prev = nullptr;
+			root = __meld(root, sub);
+			delete p;
+			--count;
+		}
+		else
+		{
+			pop();
+		}
+	}
+
+	// 将 rhs 的全部元素并入此堆，O(1)，rhs 中的句柄继续有效
+	void merge(pairing_heap& rhs)
+	{
+		if (this == &rhs) return;
+		root = __meld(root, rhs.root);
+		count += rhs.count;
+		rhs.root = nullptr;
+		rhs.count = 0;
+	}
+
+	void clear()noexcept
+	{
+		// 不使用递归，避免退化成链时栈溢出
+		node* p = root;
+		while (p != nullptr)
+		{
+			if (p->child != nullptr)
+			{
+				// 将子链接到兄弟链的头部
+				node* c = p->child;
+				while (c->sibling != nullptr) c = c->sibling;
+				c->sibling = p->sibling;
+				p->sibling = p->child;
+				p->child = nullptr;
+			}
+			node* next = p->sibling;
+			delete p;
+			p = next;
+		}
+		root = nullptr;
+		count = 0;
+	}
+
+private:
+	// 合并两棵树，优先级低的成为另一个的第一个子节点
+	node* __meld(node* a, node* b)
+	{
+		if (a == nullptr) return b;
+		if (b == nullptr) return a;
+		if (comp_pass.first()(a->value, b->value)) std::swap(a, b);
+		b->prev = a;
+		b->sibling = a->child;
+		if (a->child != nullptr) a->child->prev = b;
+		a->child = b;
+		a->sibling = nullptr;
+		return a;
+	}
+
+	// 两趟合并：从左到右两两合并，再从右到左逐个合并
+	node* __merge_pairs(node* first)
+	{
+		if (first == nullptr) return nullptr;
+		std::vector<node*>& pass = comp_pass.second();
+		pass.clear();
+		while (first != nullptr)
+		{
+			node* a = first;
+			node* b = a->sibling;
+			first = b != nullptr ? b->sibling : nullptr;
+			a->sibling = a->prev = nullptr;
+			if (b != nullptr) b->sibling = b->prev = nullptr;
+			pass.push_back(__meld(a, b));
+		}
+		node* result = pass.back();
+		for (size_t i = pass.size() - 1; i-- > 0;)
+			result = __meld(pass[i], result);
+		return result;
+	}
+
+	// 将以 p 为根的子树从其父节点上摘下
+	void __detach(node* p)noexcept
+	{
+		if (p->prev->child == p) p->prev->child = p->sibling;
+		else p->prev->sibling = p->sibling;
+		if (p->sibling != nullptr) p->sibling->prev = p->prev;
+		p->sibling = p->prev = nullptr;
+	}
+
+	void __promote(node* p)
+	{
+		if (p == root) return;
+		__detach(p);
+		root = __meld(root, p);
+	}
+};
+
+
+/**
+ * radix_heap
+ * 单调整数键的小顶堆，要求每次压入的键不小于最近一次弹出的键(Dijkstra 等算法满足此条件)
+ * 按与上次弹出键的最高不同位分桶，每个元素至多被重新分配 64 次，push 为 O(1)
+ * 仅对 bool 以外的整数键启用
+ */
+template<class Key, class Value, class = std::enable_if_t<is_integral_v<Key> && !is_same_v<remove_cv_t<Key>, bool>>>
+class radix_heap
+{
+public:
+	using key_type		= Key;
+	using mapped_type	= Value;
+	using value_type	= pair<Key, Value>;
+	using size_type		= size_t;
+
+private:
+	using ukey_type = std::make_unsigned_t<Key>;
+	static constexpr size_t bucket_count = sizeof(Key) * 8 + 1;
+
+	std::vector<value_type>	buckets[bucket_count];
+	ukey_type				last	= 0;	// 最近一次弹出的键(映射为无符号)
+	size_type				count	= 0;
+
+public:
+	radix_heap() = default;
+
+	SX_NODISCARD bool empty()const noexcept { return count == 0; }
+	size_type size()const noexcept { return count; }
+
+	void push(Key key, const Value& value)
+	{
+		if (__to_unsigned(key) < last) throw std::out_of_range("radix_heap: key is smaller than the last popped key");
+		buckets[__bucket(__to_unsigned(key))].push_back(value_type(key, value));
+		++count;
+	}
+
+	/**
+	 * 堆顶元素
+	 * 桶 0 为空时在第一个非空桶中查找最小键，不重新分桶，
+	 * 因此 last 始终是最近一次弹出的键，查看堆顶后仍然可以压入小于堆顶的键
+	 */
+	const value_type& top()const
+	{
+		if (!buckets[0].empty()) return buckets[0].back();
+		return *__min_element(buckets[__first_nonempty()]);
+	}
+
+	Key top_key()const
+	{
+		return top().first;
+	}
+
+	void pop()
+	{
+		__refill();
+		buckets[0].pop_back();
+		--count;
+	}
+
+	void clear()noexcept
+	{
+		for (auto& b : buckets) b.clear();
+		last = 0;
+		count = 0;
+	}
+
+private:
+	// 有符号键翻转符号位，使无符号比较与原比较一致
+	static ukey_type __to_unsigned(Key key)noexcept
+	{
+		if constexpr (std::is_signed_v<Key>)
+			return static_cast<ukey_type>(key) ^ (ukey_type(1) << (sizeof(Key) * 8 - 1));
+		else
+			return static_cast<ukey_type>(key);
+	}
+
+	size_t __bucket(ukey_type key)const noexcept
+	{
+		return static_cast<size_t>(bit_width(static_cast<uint64_t>(key ^ last)));
+	}
+
+	size_t __first_nonempty()const noexcept
+	{
+		size_t i = 1;
+		while (buckets[i].empty()) ++i;
+		return i;
+	}
+
+	static const value_type* __min_element(const std::vector<value_type>& bucket)noexcept
+	{
+		const value_type* lowest = &bucket[0];
+		for (const value_type& item : bucket)
+		{
+			if (__to_unsigned(item.first) < __to_unsigned(lowest->first)) lowest = &item;
+		}
+		return lowest;
+	}
+
+	// 桶 0 为空时，取第一个非空桶的最小键作为新的 last，并将该桶的元素重新分配
+	// 只在 pop 中调用，随后弹出的正是键为 last 的元素
+	void __refill()
+	{
+		if (!buckets[0].empty()) return;
+		const size_t i = __first_nonempty();
+		last = __to_unsigned(__min_element(buckets[i])->first);
+		for (value_type& item : buckets[i])
+			buckets[__bucket(__to_unsigned(item.first))].push_back(std::move(item));
+		buckets[i].clear();
+	}
+};
+
+SX_NAMESPACE_END
+#endif	// end define _SX_PRIORITY_QUEUE_H_
@@ -0,0 +1,592 @@
+﻿/**************************************************
+ * @brief   : 无锁容器的内存回收：基于纪元的回收与危险指针
+ * @file    : sx_reclaim.h
+ * @author  : 宋旭
+ * @date    : 2026年10月18日，18:30:54
+ **************************************************/
+
+#ifndef _SX_RECLAIM_H_
+#define _SX_RECLAIM_H_
+#include <algorithm>		// sort, binary_search, remove_if, find_if
+#include <atomic>			// atomic
+#include <condition_variable>	// condition_variable
+#include <cstdint>			// uint64_t
+#include <mutex>			// mutex, lock_guard, unique_lock
+#include <stdexcept>		// length_error
+#include <vector>			// vector
+#include "sx_def.h"
+
+SX_NAMESPACE_BEGIN
+
+/**
+ * 两种回收域提供相同形式的接口，无锁容器可以将回收域作为模板参数：
+ *
+ * auto g = domain.make_guard();		// 进入临界区
+ * T* p = g.protect(atomic_ptr);		// 读取一个共享指针，在 g 有效期间 p 不会被释放
+ * domain.retire(p);					// p 已从数据结构中摘除，待安全时释放
+ *
+ * epoch_domain				-- 纪元回收，读者开销极低，但一个停滞的读者会阻止全部回收
+ * hazard_pointer_domain	-- 危险指针，每次 protect 需要一次存储和栅栏，未回收内存有上界
+ *
+ * 每个线程在首次使用某个回收域时绑定一条线程记录，线程退出时释放该记录供其他线程复用
+ * 回收域析构时释放全部尚未回收的对象，此时不能再有线程在使用它
+ */
+
+namespace detail {
+	// 等待回收的对象
+	struct __retired_object
+	{
+		void*		ptr;
+		void		(*deleter)(void*);
+		uint64_t	epoch;
+	};
+
+	template<class T>
+	inline void __delete_object(void* p)
+	{
+		delete static_cast<T*>(p);
+	}
+
+	/**
+	 * 释放 list 中满足 safe 的对象
+	 * 删除函数可能再次向同一个回收域摘除对象，因此先将列表取出，处理完再与期间新增的对象合并
+	 */
+	template<class Predicate>
+	inline void __retire_each(std::vector<__retired_object>& list, Predicate safe)
+	{
+		std::vector<__retired_object> pending;
+		pending.swap(list);
+		auto last = std::remove_if(pending.begin(), pending.end(), [&](const __retired_object& r) {
+			if (!safe(r)) return false;
+			r.deleter(r.ptr);
+			return true;
+		});
+		pending.erase(last, pending.end());
+		pending.insert(pending.end(), list.begin(), list.end());
+		list.swap(pending);
+	}
+
+	// 线程记录的基类，记录挂在回收域的无锁链表上，直到回收域析构才释放
+	struct __reclaim_record
+	{
+		std::atomic<bool>				in_use{ false };
+		__reclaim_record*				next = nullptr;
+		std::vector<__retired_object>	retired;
+
+		virtual ~__reclaim_record() = default;
+
+		// 所属线程退出时调用
+		virtual void thread_exit() = 0;
+	};
+
+	/**
+	 * 记录仍然存活的回收域，线程退出时据此判断记录是否还能访问
+	 * 退出的线程处理某个回收域的记录期间将其钉住(pin)，该回收域的析构等待钉住解除后才释放记录
+	 * 锁只保护登记表本身，不在持有锁时调用使用者的代码
+	 */
+	struct __reclaim_registry
+	{
+		struct entry
+		{
+			uint64_t	id;
+			size_t		pins;
+		};
+
+		std::mutex				lock;
+		std::condition_variable	unpinned;
+		std::vector<entry>		live;
+		uint64_t				next_id = 1;
+
+		static __reclaim_registry& instance()
+		{
+			static __reclaim_registry registry;
+			return registry;
+		}
+
+		uint64_t add()
+		{
+			std::lock_guard<std::mutex> g(lock);
+			live.push_back({ next_id, 0 });
+			return next_id++;
+		}
+
+		// 等待所有退出中的线程处理完该回收域的记录
+		void remove(uint64_t id)
+		{
+			std::unique_lock<std::mutex> g(lock);
+			unpinned.wait(g, [&] { return __find(id)->pins == 0; });
+			live.erase(__find(id));
+		}
+
+		// 回收域仍然存活时钉住并返回 true
+		bool pin(uint64_t id)
+		{
+			std::lock_guard<std::mutex> g(lock);
+			auto it = __find(id);
+			if (it == live.end()) return false;
+			++it->pins;
+			return true;
+		}
+
+		void unpin(uint64_t id)
+		{
+			{
+				std::lock_guard<std::mutex> g(lock);
+				--__find(id)->pins;
+			}
+			unpinned.notify_all();
+		}
+
+	private:
+		std::vector<entry>::iterator __find(uint64_t id)
+		{
+			return std::find_if(live.begin(), live.end(), [id](const entry& e) { return e.id == id; });
+		}
+	};
+
+	// 当前线程已绑定的记录
+	struct __thread_bindings
+	{
+		struct binding
+		{
+			uint64_t			domain;
+			__reclaim_record*	record;
+		};
+
+		std::vector<binding> items;
+
+		// 线程退出时递增，使各回收域缓存的本线程记录失效
+		static inline thread_local uint64_t generation = 0;
+
+		static __thread_bindings& local()
+		{
+			thread_local __thread_bindings bindings;
+			return bindings;
+		}
+
+		__reclaim_record* find(uint64_t domain)const noexcept
+		{
+			for (const binding& b : items)
+				if (b.domain == domain) return b.record;
+			return nullptr;
+		}
+
+		/**
+		 * thread_exit 会调用使用者的删除函数，删除函数可以构造或析构其他回收域，
+		 * 也可以向本线程尚未绑定的回收域摘除对象(新的绑定加入 items)，
+		 * 因此每一轮先取出全部绑定，逐个钉住回收域后在不持有锁的情况下调用 thread_exit，
+		 * 直到删除函数不再产生新的绑定
+		 * 删除函数不能析构正在处理的回收域本身
+		 */
+		~__thread_bindings()
+		{
+			__reclaim_registry& registry = __reclaim_registry::instance();
+			while (!items.empty())
+			{
+				std::vector<binding> snapshot;
+				snapshot.swap(items);
+				++generation;
+				for (const binding& b : snapshot)
+				{
+					if (!registry.pin(b.domain)) continue;
+					b.record->thread_exit();
+					registry.unpin(b.domain);
+				}
+			}
+		}
+	};
+
+	/**
+	 * 回收域的公共部分：线程记录链表与线程绑定
+	 * Record 须派生自 __reclaim_record
+	 */
+	template<class Record>
+	class __reclaim_domain_base
+	{
+	protected:
+		std::atomic<Record*>	head{ nullptr };
+		std::atomic<size_t>		record_count{ 0 };
+		uint64_t				id;
+
+	protected:
+		__reclaim_domain_base() : id(__reclaim_registry::instance().add()) {}
+
+		~__reclaim_domain_base()
+		{
+			__reclaim_registry::instance().remove(id);
+			Record* p = head.load(std::memory_order_acquire);
+			while (p != nullptr)
+			{
+				Record* next = static_cast<Record*>(p->next);
+				for (const __retired_object& r : p->retired) r.deleter(r.ptr);
+				delete p;
+				p = next;
+			}
+		}
+
+		// 取得当前线程的记录，首次调用时绑定
+		Record* __local_record()
+		{
+			struct cache_entry
+			{
+				uint64_t	domain		= 0;
+				uint64_t	generation	= 0;
+				Record*		record		= nullptr;
+			};
+			thread_local cache_entry cache;
+			if (cache.domain == id && cache.generation == __thread_bindings::generation) return cache.record;
+
+			__thread_bindings& bindings = __thread_bindings::local();
+			Record* rec = static_cast<Record*>(bindings.find(id));
+			if (rec == nullptr)
+			{
+				rec = __acquire_record();
+				bindings.items.push_back({ id, rec });
+			}
+			cache.domain = id;
+			cache.generation = __thread_bindings::generation;
+			cache.record = rec;
+			return rec;
+		}
+
+		template<class Function>
+		void __for_each_record(Function f)const
+		{
+			for (Record* p = head.load(std::memory_order_acquire); p != nullptr; p = static_cast<Record*>(p->next))
+				f(*p);
+		}
+
+	private:
+		// 复用空闲的记录，没有则新建并挂到链表头部
+		Record* __acquire_record()
+		{
+			for (Record* p = head.load(std::memory_order_acquire); p != nullptr; p = static_cast<Record*>(p->next))
+			{
+				bool expected = false;
+				if (!p->in_use.load(std::memory_order_relaxed) &&
+					p->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire))
+				{
+					return p;
+				}
+			}
+
+			Record* rec = new Record(static_cast<typename Record::domain_type*>(this));
+			rec->in_use.store(true, std::memory_order_relaxed);
+			record_count.fetch_add(1, std::memory_order_relaxed);
+			Record* old = head.load(std::memory_order_relaxed);
+			do
+			{
+				rec->next = old;
+			} while (!head.compare_exchange_weak(old, rec, std::memory_order_release, std::memory_order_relaxed));
+			return rec;
+		}
+	};
+}
+
+
+/**
+ * epoch_domain
+ * 全局纪元 + 每线程的本地纪元
+ * 进入临界区时将本地纪元设为全局纪元，退出时清除
+ * 当所有处于临界区的线程都已观察到当前全局纪元时，全局纪元才能前进
+ * 在纪元 e 被摘除的对象，在全局纪元到达 e + 2 后一定不再被任何线程引用
+ * 摘除的对象先放入线程本地的列表，积累到一定数量后才批量尝试回收
+ */
+class epoch_domain;
+
+namespace detail {
+	struct __epoch_record : __reclaim_record
+	{
+		using domain_type = epoch_domain;
+
+		// 0 表示不在临界区，否则为 (纪元 << 1) | 1
+		alignas(64) std::atomic<uint64_t>	local{ 0 };
+		unsigned							nesting = 0;
+		epoch_domain*						domain;
+
+		explicit __epoch_record(epoch_domain* d) : domain(d) {}
+
+		void thread_exit()override;
+	};
+}
+
+class epoch_domain : private detail::__reclaim_domain_base<detail::__epoch_record>
+{
+	friend class detail::__reclaim_domain_base<detail::__epoch_record>;
+	friend struct detail::__epoch_record;
+
+private:
+	using record = detail::__epoch_record;
+
+	alignas(64) std::atomic<uint64_t>	global{ 1 };
+	size_t								threshold;
+
+public:
+	// 临界区守卫，可嵌套
+	class guard
+	{
+	private:
+		record* rec;
+
+	public:
+		explicit guard(epoch_domain& domain) : rec(domain.__local_record())
+		{
+			if (rec->nesting++ == 0)
+			{
+				uint64_t e = domain.global.load(std::memory_order_relaxed);
+				rec->local.store((e << 1) | 1, std::memory_order_relaxed);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+			}
+		}
+
+		guard(const guard&) = delete;
+		guard& operator=(const guard&) = delete;
+
+		~guard()
+		{
+			if (--rec->nesting == 0) rec->local.store(0, std::memory_order_release);
+		}
+
+		// 纪元回收中读取不需要额外的操作
+		template<class T>
+		T* protect(const std::atomic<T*>& src)const noexcept
+		{
+			return src.load(std::memory_order_acquire);
+		}
+	};
+
+public:
+	// threshold 为线程本地待回收对象达到多少个时尝试回收
+	explicit epoch_domain(size_t threshold = 64) : threshold(threshold) {}
+
+	epoch_domain(const epoch_domain&) = delete;
+	epoch_domain& operator=(const epoch_domain&) = delete;
+
+	~epoch_domain() = default;
+
+	// 进程范围的默认回收域
+	static epoch_domain& global_domain()
+	{
+		static epoch_domain domain;
+		return domain;
+	}
+
+	SX_NODISCARD guard make_guard() { return guard(*this); }
+	SX_NODISCARD guard pin() { return guard(*this); }
+
+	template<class T>
+	void retire(T* p)
+	{
+		retire(static_cast<void*>(p), &detail::__delete_object<T>);
+	}
+
+	void retire(void* p, void (*deleter)(void*))
+	{
+		record* rec = __local_record();
+		rec->retired.push_back({ p, deleter, global.load(std::memory_order_relaxed) });
+		if (rec->retired.size() >= threshold) __collect(rec);
+	}
+
+	// 尝试推进纪元并回收当前线程中已经安全的对象
+	void collect()
+	{
+		__collect(__local_record());
+	}
+
+	uint64_t epoch()const noexcept
+	{
+		return global.load(std::memory_order_relaxed);
+	}
+
+private:
+	// 所有处于临界区的线程都已观察到当前纪元时，纪元前进一步
+	bool __try_advance()
+	{
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		uint64_t e = global.load(std::memory_order_relaxed);
+		bool ready = true;
+		__for_each_record([&](const record& r) {
+			uint64_t local = r.local.load(std::memory_order_acquire);
+			if ((local & 1) != 0 && (local >> 1) != e) ready = false;
+		});
+		if (!ready) return false;
+		return global.compare_exchange_strong(e, e + 1, std::memory_order_acq_rel);
+	}
+
+	void __collect(record* rec)
+	{
+		__try_advance();
+		uint64_t e = global.load(std::memory_order_acquire);
+		detail::__retire_each(rec->retired, [e](const detail::__retired_object& r) { return r.epoch + 2 <= e; });
+	}
+};
+
+inline void detail::__epoch_record::thread_exit()
+{
+	nesting = 0;
+	local.store(0, std::memory_order_release);
+	domain->__collect(this);
+	in_use.store(false, std::memory_order_release);
+}
+
+
+/**
+ * hazard_pointer_domain
+ * 每个线程记录有固定数量的危险指针槽位，读者在访问共享对象之前将其地址发布到槽位中
+ * 回收时收集所有槽位中的指针，只释放未被任何槽位引用的对象
+ * 待回收对象数量达到阈值(与线程数成正比)才扫描一次，扫描的代价均摊到每次 retire
+ */
+class hazard_pointer_domain;
+
+namespace detail {
+	struct __hazard_record : __reclaim_record
+	{
+		using domain_type = hazard_pointer_domain;
+		static constexpr size_t slot_count = 8;
+
+		std::atomic<void*>		slots[slot_count] = {};
+		unsigned				used = 0;		// 已被守卫占用的槽位掩码，仅所属线程访问
+		hazard_pointer_domain*	domain;
+
+		explicit __hazard_record(hazard_pointer_domain* d) : domain(d) {}
+
+		void thread_exit()override;
+	};
+}
+
+class hazard_pointer_domain : private detail::__reclaim_domain_base<detail::__hazard_record>
+{
+	friend class detail::__reclaim_domain_base<detail::__hazard_record>;
+	friend struct detail::__hazard_record;
+
+private:
+	using record = detail::__hazard_record;
+
+	size_t	threshold;
+
+public:
+	static constexpr size_t slots_per_thread = record::slot_count;
+
+	// 占用一个危险指针槽位的守卫
+	class guard
+	{
+	private:
+		record*	rec;
+		size_t	slot;
+
+	public:
+		explicit guard(hazard_pointer_domain& domain) : rec(domain.__local_record())
+		{
+			if (rec->used == (1u << record::slot_count) - 1)
+				throw std::length_error("hazard_pointer_domain: too many guards in one thread");
+			slot = 0;
+			while (rec->used & (1u << slot)) ++slot;
+			rec->used |= 1u << slot;
+		}
+
+		guard(const guard&) = delete;
+		guard& operator=(const guard&) = delete;
+
+		~guard()
+		{
+			rec->slots[slot].store(nullptr, std::memory_order_release);
+			rec->used &= ~(1u << slot);
+		}
+
+		// 读取 src 并发布到槽位，直到发布后 src 未发生变化
+		template<class T>
+		T* protect(const std::atomic<T*>& src)noexcept
+		{
+			T* p = src.load(std::memory_order_relaxed);
+			for (;;)
+			{
+				rec->slots[slot].store(p, std::memory_order_relaxed);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				T* q = src.load(std::memory_order_acquire);
+				if (q == p) return p;
+				p = q;
+			}
+		}
+
+		// 直接发布一个已知仍然有效的指针
+		template<class T>
+		void reset(T* p)noexcept
+		{
+			rec->slots[slot].store(p, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+		}
+
+		void reset()noexcept
+		{
+			rec->slots[slot].store(nullptr, std::memory_order_release);
+		}
+	};
+
+public:
+	// threshold 为扫描阈值的下限，实际阈值还与线程记录数成正比
+	explicit hazard_pointer_domain(size_t threshold = 64) : threshold(threshold) {}
+
+	hazard_pointer_domain(const hazard_pointer_domain&) = delete;
+	hazard_pointer_domain& operator=(const hazard_pointer_domain&) = delete;
+
+	~hazard_pointer_domain() = default;
+
+	// 进程范围的默认回收域
+	static hazard_pointer_domain& global_domain()
+	{
+		static hazard_pointer_domain domain;
+		return domain;
+	}
+
+	SX_NODISCARD guard make_guard() { return guard(*this); }
+
+	template<class T>
+	void retire(T* p)
+	{
+		retire(static_cast<void*>(p), &detail::__delete_object<T>);
+	}
+
+	void retire(void* p, void (*deleter)(void*))
+	{
+		record* rec = __local_record();
+		rec->retired.push_back({ p, deleter, 0 });
+		size_t limit = 2 * record::slot_count * record_count.load(std::memory_order_relaxed);
+		if (rec->retired.size() >= (limit > threshold ? limit : threshold)) __scan(rec);
+	}
+
+	// 立即扫描并回收当前线程中未被引用的对象
+	void collect()
+	{
+		__scan(__local_record());
+	}
+
+private:
+	void __scan(record* rec)
+	{
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		std::vector<void*> hazards;
+		__for_each_record([&](const record& r) {
+			for (const auto& s : r.slots)
+			{
+				void* p = s.load(std::memory_order_acquire);
+				if (p != nullptr) hazards.push_back(p);
+			}
+		});
+		std::sort(hazards.begin(), hazards.end());
+
+		detail::__retire_each(rec->retired, [&](const detail::__retired_object& r) {
+			return !std::binary_search(hazards.begin(), hazards.end(), r.ptr);
+		});
+	}
+};
+
+inline void detail::__hazard_record::thread_exit()
+{
+	for (auto& s : slots) s.store(nullptr, std::memory_order_release);
+	used = 0;
+	domain->__scan(this);
+	in_use.store(false, std::memory_order_release);
+}
+
+SX_NAMESPACE_END
+#endif	// end define _SX_RECLAIM_H_
@@ -0,0 +1,568 @@
+﻿/**************************************************
+ * @brief   : 零拷贝的二进制序列化格式
+ * @file    : sx_serialize.h
+ * @author  : 宋旭
+ * @date    : 2026年10月18日，16:40:12
+ **************************************************/
+
+#ifndef _SX_SERIALIZE_H_
+#define _SX_SERIALIZE_H_
+#include <cstddef>			// offsetof
+#include <cstdint>			// int64_t, uint64_t, uintptr_t
+#include <functional>		// less
+#include <cstring>			// memcpy, memcmp
+#include <stdexcept>		// invalid_argument
+#include <string>			// string
+#include <string_view>		// string_view
+#include <vector>			// vector
+#include <map>				// map
+#include <unordered_map>	// unordered_map
+#include <iterator>			// iterator_traits
+#include "sx_type_traits.h"
+
+SX_NAMESPACE_BEGIN
+
+/**
+ * 序列化结果是一块可重定位的内存，内部的指针全部以 "相对自身地址的偏移量" 存储
+ * 因此可以直接在内存缓冲区或被映射的文件(例如 mmap_vector<unsigned char>)上原地读取，
+ * 读取时不需要解析，也不需要任何内存分配
+ *
+ * 布局类型(只读)：
+ * rel_ptr<T>				相对指针
+ * rel_vector<T>			连续数组
+ * rel_string				字符串，末尾带 '\0'
+ * rel_pair<K, V>			键值对
+ * rel_flat_map<K, V>		按键有序的数组，二分查找
+ * rel_hash_map<K, V>		开放寻址哈希表，线性探测
+ *
+ * 缓冲区起始地址至少需要按 16 字节对齐
+ */
+
+
+// 相对指针，保存目标地址相对于自身地址的偏移量，0 表示空指针
+template<class T>
+class rel_ptr
+{
+private:
+	int64_t offset;
+
+public:
+	rel_ptr(const rel_ptr&) = delete;
+	rel_ptr& operator=(const rel_ptr&) = delete;
+
+	const T* get()const noexcept
+	{
+		return offset == 0 ? nullptr :
+			reinterpret_cast<const T*>(reinterpret_cast<const char*>(this) + offset);
+	}
+
+	const T* operator->()const noexcept { return get(); }
+	const T& operator*()const noexcept { return *get(); }
+	explicit operator bool()const noexcept { return offset != 0; }
+};
+
+
+// 连续数组
+template<class T>
+class rel_vector
+{
+private:
+	rel_ptr<T>	first;
+	uint64_t	count;
+
+public:
+	using value_type		= T;
+	using size_type			= size_t;
+	using difference_type	= ptrdiff_t;
+	using const_reference	= const T&;
+	using const_pointer		= const T*;
+	using const_iterator	= const T*;
+	using iterator			= const_iterator;
+
+	rel_vector(const rel_vector&) = delete;
+	rel_vector& operator=(const rel_vector&) = delete;
+
+	const_pointer data()const noexcept { return first.get(); }
+	size_type size()const noexcept { return static_cast<size_type>(count); }
+	SX_NODISCARD bool empty()const noexcept { return count == 0; }
+
+	const_iterator begin()const noexcept { return data(); }
+	const_iterator end()const noexcept { return data() + size(); }
+
+	const_reference operator[](size_type n)const { return data()[n]; }
+
+	const_reference at(size_type n)const
+	{
+		if (n >= size()) throw std::out_of_range("rel_vector::at");
+		return data()[n];
+	}
+
+	const_reference front()const { return data()[0]; }
+	const_reference back()const { return data()[size() - 1]; }
+};
+
+
+// 字符串，size() 不包含末尾的 '\0'
+class rel_string : public rel_vector<char>
+{
+public:
+	const char* c_str()const noexcept { return empty() ? "" : data(); }
+	std::string_view view()const noexcept { return std::string_view(c_str(), size()); }
+	operator std::string_view()const noexcept { return view(); }
+
+	friend bool operator==(const rel_string& lhs, std::string_view rhs) { return lhs.view() == rhs; }
+	friend bool operator!=(const rel_string& lhs, std::string_view rhs) { return lhs.view() != rhs; }
+};
+
+
+// 键值对
+template<class K, class V>
+struct rel_pair
+{
+	K first;
+	V second;
+};
+
+
+namespace detail {
+	// 取得用于比较和哈希的键，字符串统一转为 string_view
+	template<class K>
+	inline const K& __serial_key(const K& key) { return key; }
+
+	inline std::string_view __serial_key(const rel_string& key) { return key.view(); }
+
+	// 哈希函数是格式的一部分，写入与读取必须一致，不可随意修改
+	inline uint64_t __serial_mix(uint64_t x)noexcept
+	{
+		x ^= x >> 30;
+		x *= 0xbf58476d1ce4e5b9ULL;
+		x ^= x >> 27;
+		x *= 0x94d049bb133111ebULL;
+		x ^= x >> 31;
+		return x;
+	}
+
+	inline uint64_t __serial_hash(std::string_view s)noexcept
+	{
+		uint64_t h = 0x9e3779b97f4a7c15ULL ^ s.size();
+		const char* p = s.data();
+		size_t n = s.size();
+		for (; n >= 8; n -= 8, p += 8)
+		{
+			uint64_t w;
+			std::memcpy(&w, p, 8);
+			h = __serial_mix(h ^ w);
+		}
+		uint64_t tail = 0;
+		std::memcpy(&tail, p, n);
+		return __serial_mix(h ^ tail);
+	}
+
+	template<class K>
+	inline uint64_t __serial_hash(const K& key)noexcept
+	{
+		static_assert(is_integral_v<K> || is_enum_v<K>, "rel_hash_map key must be integral, enum or string");
+		return __serial_mix(static_cast<uint64_t>(key));
+	}
+
+	// 序列化缓冲区的文件头
+	struct __serial_header
+	{
+		char		magic[8];
+		uint32_t	version;
+		uint32_t	reserved;
+		uint64_t	root;		// 根对象相对缓冲区起始处的偏移量
+		uint64_t	total;		// 缓冲区总字节数
+	};
+
+	constexpr char __serial_magic[8] = { 'S', 'X', 'S', 'E', 'R', 'I', 'A', 'L' };
+	constexpr uint32_t __serial_version = 1;
+	constexpr size_t __serial_max_align = 16;	// 布局类型的最大对齐，也是缓冲区起始地址的对齐要求
+}
+
+
+// 有序数组形式的映射，由 std::map 序列化而来
+template<class K, class V>
+class rel_flat_map
+{
+private:
+	rel_vector<rel_pair<K, V>> entries;
+
+public:
+	using key_type			= K;
+	using mapped_type		= V;
+	using value_type		= rel_pair<K, V>;
+	using size_type			= size_t;
+	using const_iterator	= const value_type*;
+	using iterator			= const_iterator;
+
+	rel_flat_map(const rel_flat_map&) = delete;
+	rel_flat_map& operator=(const rel_flat_map&) = delete;
+
+	size_type size()const noexcept { return entries.size(); }
+	SX_NODISCARD bool empty()const noexcept { return entries.empty(); }
+	const_iterator begin()const noexcept { return entries.begin(); }
+	const_iterator end()const noexcept { return entries.end(); }
+
+	// 第一个不小于 key 的元素
+	template<class Q>
+	const_iterator lower_bound(const Q& key)const
+	{
+		const_iterator first = begin();
+		size_type n = size();
+		while (n > 0)
+		{
+			size_type half = n / 2;
+			if (detail::__serial_key(first[half].first) < key)
+			{
+				first += half + 1;
+				n -= half + 1;
+			}
+			else
+			{
+				n = half;
+			}
+		}
+		return first;
+	}
+
+	template<class Q>
+	const_iterator find(const Q& key)const
+	{
+		const_iterator it = lower_bound(key);
+		return it != end() && !(key < detail::__serial_key(it->first)) ? it : end();
+	}
+
+	template<class Q>
+	bool contains(const Q& key)const { return find(key) != end(); }
+
+	template<class Q>
+	const V& at(const Q& key)const
+	{
+		const_iterator it = find(key);
+		if (it == end()) throw std::out_of_range("rel_flat_map::at");
+		return it->second;
+	}
+};
+
+
+// 开放寻址的哈希映射，由 std::unordered_map 序列化而来
+// 槽位数为 2 的幂且不小于元素个数的两倍，槽中保存 "元素下标 + 1"，0 表示空槽
+template<class K, class V>
+class rel_hash_map
+{
+private:
+	rel_vector<rel_pair<K, V>>	entries;
+	rel_vector<uint32_t>		slots;
+
+public:
+	using key_type			= K;
+	using mapped_type		= V;
+	using value_type		= rel_pair<K, V>;
+	using size_type			= size_t;
+	using const_iterator	= const value_type*;
+	using iterator			= const_iterator;
+
+	rel_hash_map(const rel_hash_map&) = delete;
+	rel_hash_map& operator=(const rel_hash_map&) = delete;
+
+	size_type size()const noexcept { return entries.size(); }
+	SX_NODISCARD bool empty()const noexcept { return entries.empty(); }
+	const_iterator begin()const noexcept { return entries.begin(); }
+	const_iterator end()const noexcept { return entries.end(); }
+
+	template<class Q>
+	const_iterator find(const Q& key)const
+	{
+		if (slots.empty()) return end();
+		const size_type mask = slots.size() - 1;
+		size_type i = static_cast<size_type>(__hash(key)) & mask;
+		while (slots[i] != 0)
+		{
+			const value_type& e = entries[slots[i] - 1];
+			if (detail::__serial_key(e.first) == key) return &e;
+			i = (i + 1) & mask;
+		}
+		return end();
+	}
+
+	template<class Q>
+	bool contains(const Q& key)const { return find(key) != end(); }
+
+	template<class Q>
+	const V& at(const Q& key)const
+	{
+		const_iterator it = find(key);
+		if (it == end()) throw std::out_of_range("rel_hash_map::at");
+		return it->second;
+	}
+
+private:
+	template<class Q>
+	static uint64_t __hash(const Q& key)
+	{
+		if constexpr (is_same_v<K, rel_string>)
+			return detail::__serial_hash(std::string_view(key));
+		else
+			return detail::__serial_hash(static_cast<K>(key));
+	}
+};
+
+
+class serializer;
+
+/**
+ * serialize_traits
+ * 描述一个源类型如何写入缓冲区：
+ * layout_type	-- 该类型在缓冲区中的布局类型
+ * write		-- 将对象写入缓冲区中偏移量为 at 的 layout_type 处(空间已分配)
+ *
+ * 可平凡复制的类型按原始内存写入，布局类型就是其本身
+ * 可通过特化此模板支持自定义类型
+ */
+template<class T>
+struct serialize_traits
+{
+	static_assert(is_trivially_copyable_v<T>, "no serialize_traits specialization for this type");
+	static_assert(!is_pointer_v<T> && !is_member_pointer_v<T>, "pointers can not be serialized");
+
+	using layout_type = T;
+
+	static void write(serializer& s, size_t at, const T& value);
+};
+
+template<class T>
+using serialize_layout_t = typename serialize_traits<T>::layout_type;
+
+
+/**
+ * serializer
+ * 在一块连续增长的缓冲区中构建序列化结果
+ * 缓冲区可能重新分配，因此内部一律使用相对缓冲区起始处的偏移量
+ */
+class serializer
+{
+private:
+	std::vector<unsigned char> buffer;
+
+public:
+	serializer()
+	{
+		buffer.resize(sizeof(detail::__serial_header));
+	}
+
+	// 分配 bytes 字节并按 align 对齐，新空间清零，返回其偏移量
+	size_t allocate(size_t bytes, size_t align)
+	{
+		size_t at = (buffer.size() + align - 1) & ~(align - 1);
+		buffer.resize(at + bytes);
+		return at;
+	}
+
+	unsigned char* at(size_t offset)noexcept { return buffer.data() + offset; }
+
+	// 在偏移量 where 处写入一个平凡对象
+	template<class T>
+	void store(size_t where, const T& value)noexcept
+	{
+		std::memcpy(at(where), &value, sizeof(T));
+	}
+
+	// 令偏移量 where 处的 rel_ptr 指向偏移量 target
+	void link(size_t where, size_t target)noexcept
+	{
+		store<int64_t>(where, static_cast<int64_t>(target) - static_cast<int64_t>(where));
+	}
+
+	// 写入一段元素，并在偏移量 where 处填写对应的 rel_vector
+	// 元素类型与布局类型相同且可平凡复制时，整块复制
+	template<class Iterator>
+	void write_sequence(size_t where, Iterator first, size_t count)
+	{
+		using source_type = typename std::iterator_traits<Iterator>::value_type;
+		using layout = serialize_layout_t<source_type>;
+		static_assert(alignof(layout) <= detail::__serial_max_align, "layout alignment is too large");
+
+		size_t data = allocate(count * sizeof(layout), alignof(layout));
+		if constexpr (is_pointer_v<Iterator> && is_same_v<layout, source_type>)
+		{
+			if (count != 0) std::memcpy(at(data), first, count * sizeof(layout));
+		}
+		else
+		{
+			for (size_t i = 0; i < count; ++i, ++first)
+				serialize_traits<source_type>::write(*this, data + i * sizeof(layout), *first);
+		}
+		if (count != 0) link(where, data);
+		store<uint64_t>(where + sizeof(int64_t), count);
+	}
+
+	// 写入根对象并返回完整的缓冲区，之后此对象回到初始状态
+	template<class T>
+	std::vector<unsigned char> finish(const T& root)
+	{
+		using layout = serialize_layout_t<T>;
+		size_t where = allocate(sizeof(layout), alignof(layout));
+		serialize_traits<T>::write(*this, where, root);
+
+		detail::__serial_header header = {};
+		std::memcpy(header.magic, detail::__serial_magic, sizeof(header.magic));
+		header.version = detail::__serial_version;
+		header.root = where;
+		header.total = buffer.size();
+		store(0, header);
+
+		std::vector<unsigned char> result;
+		result.swap(buffer);
+		buffer.resize(sizeof(detail::__serial_header));
+		return result;
+	}
+};
+
+
+template<class T>
+inline void serialize_traits<T>::write(serializer& s, size_t at, const T& value)
+{
+	s.store(at, value);
+}
+
+// std::vector，布局为 rel_vector
+template<class T, class Alloc>
+struct serialize_traits<std::vector<T, Alloc>>
+{
+	using layout_type = rel_vector<serialize_layout_t<T>>;
+
+	static void write(serializer& s, size_t at, const std::vector<T, Alloc>& value)
+	{
+		s.write_sequence(at, value.data(), value.size());
+	}
+};
+
+// 字符串，布局为 rel_string，额外写入末尾的 '\0'
+template<>
+struct serialize_traits<std::string_view>
+{
+	using layout_type = rel_string;
+
+	static void write(serializer& s, size_t at, std::string_view value)
+	{
+		size_t data = s.allocate(value.size() + 1, 1);
+		std::memcpy(s.at(data), value.data(), value.size());
+		s.link(at, data);
+		s.store<uint64_t>(at + sizeof(int64_t), value.size());
+	}
+};
+
+template<class Traits, class Alloc>
+struct serialize_traits<std::basic_string<char, Traits, Alloc>>
+{
+	using layout_type = rel_string;
+
+	static void write(serializer& s, size_t at, const std::basic_string<char, Traits, Alloc>& value)
+	{
+		serialize_traits<std::string_view>::write(s, at, std::string_view(value.data(), value.size()));
+	}
+};
+
+// 键值对，布局为 rel_pair
+template<class K, class V>
+struct serialize_traits<std::pair<K, V>>
+{
+	using key_layout	= serialize_layout_t<remove_cv_t<K>>;
+	using mapped_layout	= serialize_layout_t<V>;
+	using layout_type	= rel_pair<key_layout, mapped_layout>;
+
+	static void write(serializer& s, size_t at, const std::pair<K, V>& value)
+	{
+		serialize_traits<remove_cv_t<K>>::write(s, at + offsetof(layout_type, first), value.first);
+		serialize_traits<V>::write(s, at + offsetof(layout_type, second), value.second);
+	}
+};
+
+// std::map，布局为 rel_flat_map
+// rel_flat_map 按 < 二分查找，因此只接受按 < 排序的 map，元素按迭代顺序原样写入
+template<class K, class V, class Compare, class Alloc>
+struct serialize_traits<std::map<K, V, Compare, Alloc>>
+{
+	static_assert(is_same_v<Compare, std::less<K>> || is_same_v<Compare, std::less<>>,
+		"serialized std::map must be ordered by std::less");
+
+	using layout_type = rel_flat_map<serialize_layout_t<K>, serialize_layout_t<V>>;
+
+	static void write(serializer& s, size_t at, const std::map<K, V, Compare, Alloc>& value)
+	{
+		s.write_sequence(at, value.begin(), value.size());
+	}
+};
+
+// std::unordered_map，布局为 rel_hash_map
+template<class K, class V, class Hash, class Equal, class Alloc>
+struct serialize_traits<std::unordered_map<K, V, Hash, Equal, Alloc>>
+{
+	using key_layout	= serialize_layout_t<K>;
+	using layout_type	= rel_hash_map<key_layout, serialize_layout_t<V>>;
+
+	static void write(serializer& s, size_t at, const std::unordered_map<K, V, Hash, Equal, Alloc>& value)
+	{
+		const size_t n = value.size();
+		size_t slot_count = n == 0 ? 0 : 2;
+		while (slot_count < n * 2) slot_count <<= 1;
+
+		std::vector<uint32_t> slots(slot_count, 0);
+		uint32_t index = 0;
+		for (const auto& item : value)
+		{
+			uint64_t h;
+			if constexpr (is_same_v<key_layout, rel_string>)
+				h = detail::__serial_hash(std::string_view(item.first));
+			else
+				h = detail::__serial_hash(item.first);
+
+			size_t i = static_cast<size_t>(h) & (slot_count - 1);
+			while (slots[i] != 0) i = (i + 1) & (slot_count - 1);
+			slots[i] = ++index;
+		}
+
+		s.write_sequence(at, value.begin(), n);
+		s.write_sequence(at + sizeof(rel_vector<typename layout_type::value_type>), slots.data(), slots.size());
+	}
+};
+
+
+/**
+ * 将对象序列化为一块连续的缓冲区
+ */
+template<class T>
+inline std::vector<unsigned char> serialize(const T& root)
+{
+	return serializer().finish(root);
+}
+
+/**
+ * 在缓冲区上原地取得根对象，类型 T 须与写入时一致
+ * 缓冲区未按 16 字节对齐或格式不正确时抛出 invalid_argument
+ */
+template<class T>
+inline const serialize_layout_t<T>* serialized_root(const void* data, size_t size)
+{
+	using layout = serialize_layout_t<T>;
+	detail::__serial_header header;
+	if (data == nullptr || size < sizeof(header))
+		throw std::invalid_argument("serialized_root: buffer too small");
+	if (reinterpret_cast<uintptr_t>(data) % detail::__serial_max_align != 0)
+		throw std::invalid_argument("serialized_root: misaligned buffer");
+
+	// root 与 total 来自缓冲区，比较时避免相加溢出
+	std::memcpy(&header, data, sizeof(header));
+	if (std::memcmp(header.magic, detail::__serial_magic, sizeof(header.magic)) != 0 ||
+		header.version != detail::__serial_version || header.total > size ||
+		header.root > header.total || header.total - header.root < sizeof(layout) ||
+		header.root % alignof(layout) != 0)
+	{
+		throw std::invalid_argument("serialized_root: bad header");
+	}
+	return reinterpret_cast<const layout*>(static_cast<const unsigned char*>(data) + header.root);
+}
+
+SX_NAMESPACE_END
+#endif	// end define _SX_SERIALIZE_H_
@@ -0,0 +1,281 @@
+﻿/**************************************************
+ * @brief   : 无锁的并发跳表 concurrent_skiplist_map
+ * @file    : sx_skiplist.h
+ * @author  : 宋旭
+ * @date    : 2026年10月18日，22:58:06
+ **************************************************/
+
+#ifndef _SX_SKIPLIST_H_
+#define _SX_SKIPLIST_H_
+#include <atomic>			// atomic
+#include <cstdint>			// uint64_t
+#include <functional>		// less
+#include <new>				// placement new
+#include <utility>			// forward
+#include "sx_arena.h"
+#include "sx_bit.h"
+#include "sx_iterator.h"
+#include "sx_utility.h"
+
+SX_NAMESPACE_BEGIN
+
+/**
+ * concurrent_skiplist_map
+ * 有序映射，多个线程可以同时插入与查找，均不加锁(节点所在的 arena 换块也只用 CAS，
+ * 但向系统申请新块时系统分配器自身可能加锁)
+ * 每层链表的链接只由 CAS 修改：节点先以 CAS 挂入第 0 层(此时即对所有线程可见)，
+ * 再自下而上逐层挂入，CAS 失败时重新查找该层的前驱
+ *
+ * 不支持删除，节点从 arena 中分配，与容器同生命周期；
+ * 因此迭代器在并发插入时始终有效，遍历第 0 层时可能看到或看不到遍历开始后插入的元素，
+ * 但不会重复或遗漏遍历开始前已存在的元素
+ * 元素的值 V 不受保护，多个线程修改同一个值时需由使用者自行同步
+ *
+ * 塔高由线程局部的随机数生成器决定，每升高一层的概率为 1/4
+ * Backend 为 arena 申请块的方式，例如 page_allocator 可使节点位于大页中
+ */
+template<class K, class V, class Compare = std::less<K>, class Backend = detail::__new_backend>
+class concurrent_skiplist_map
+{
+public:
+	using key_type		= K;
+	using mapped_type	= V;
+	using value_type	= pair<const K, V>;
+	using size_type		= size_t;
+	using key_compare	= Compare;
+	using arena_type	= basic_arena<Backend>;
+
+	static constexpr int max_height = 32;
+
+private:
+	struct node;
+	using link = std::atomic<node*>;
+
+	static constexpr size_t node_align = alignof(link) > alignof(value_type) ? alignof(link) : alignof(value_type);
+
+	// 各层的后继指针紧跟在节点之后，个数为 height
+	struct alignas(node_align) node
+	{
+		value_type	value;
+		int			height;
+
+		template<class... Args>
+		node(int h, const K& key, Args&&... args)
+			: value(piecewise_construct, sx::forward_as_tuple(key), sx::forward_as_tuple(std::forward<Args>(args)...)), height(h) {}
+
+		link* next()noexcept { return reinterpret_cast<link*>(this + 1); }
+	};
+
+	link									head[max_height];
+	std::atomic<int>						levels{ 1 };	// 目前用到的层数，查找从这一层开始
+	std::atomic<size_t>						count{ 0 };
+	compressed_pair<Compare, arena_type>	comp_pool;		// 无状态的比较器不占用空间
+
+	const Compare& comp()const noexcept { return comp_pool.first(); }
+	arena_type& pool()noexcept { return comp_pool.second(); }
+
+public:
+	class iterator : public sx::iterator<forward_iterator_tag, value_type>
+	{
+	private:
+		node* cur = nullptr;
+
+		friend class concurrent_skiplist_map;
+		explicit iterator(node* p)noexcept : cur(p) {}
+
+	public:
+		using self = iterator;
+
+		iterator() = default;
+
+		value_type& operator*()const noexcept { return cur->value; }
+		value_type* operator->()const noexcept { return &cur->value; }
+
+		self& operator++()noexcept
+		{
+			cur = cur->next()[0].load(std::memory_order_acquire);
+			return *this;
+		}
+
+		self operator++(int)noexcept
+		{
+			auto temp = *this;
+			++*this;
+			return temp;
+		}
+
+		bool operator==(const self& rhs)const noexcept { return cur == rhs.cur; }
+		bool operator!=(const self& rhs)const noexcept { return cur != rhs.cur; }
+	};
+
+public:
+	explicit concurrent_skiplist_map(const Compare& compare = Compare(),
+		size_t arena_block_size = arena_type::default_block_size, const Backend& backend = Backend())
+		: comp_pool(piecewise_construct, sx::forward_as_tuple(compare), sx::forward_as_tuple(arena_block_size, backend))
+	{
+		for (link& l : head) l.store(nullptr, std::memory_order_relaxed);
+	}
+
+	concurrent_skiplist_map(const concurrent_skiplist_map&) = delete;
+	concurrent_skiplist_map& operator=(const concurrent_skiplist_map&) = delete;
+
+	// 析构时不能有其他线程访问；节点的内存随 arena 释放，这里只调用元素的析构函数
+	~concurrent_skiplist_map()
+	{
+		node* p = head[0].load(std::memory_order_acquire);
+		while (p != nullptr)
+		{
+			node* next = p->next()[0].load(std::memory_order_relaxed);
+			p->~node();
+			p = next;
+		}
+	}
+
+	iterator begin()const noexcept { return iterator(head[0].load(std::memory_order_acquire)); }
+	iterator end()const noexcept { return iterator(); }
+
+	// 并发插入时为近似值
+	size_type size()const noexcept { return count.load(std::memory_order_relaxed); }
+	SX_NODISCARD bool empty()const noexcept { return head[0].load(std::memory_order_acquire) == nullptr; }
+
+	iterator find(const K& key)const
+	{
+		node* p = __lower_bound(key);
+		return iterator(p != nullptr && !comp()(key, p->value.first) ? p : nullptr);
+	}
+
+	bool contains(const K& key)const { return find(key) != end(); }
+
+	// 第一个不小于 key 的元素，用于范围扫描
+	iterator lower_bound(const K& key)const { return iterator(__lower_bound(key)); }
+
+	// 第一个大于 key 的元素
+	iterator upper_bound(const K& key)const
+	{
+		node* p = __lower_bound(key);
+		if (p != nullptr && !comp()(key, p->value.first)) p = p->next()[0].load(std::memory_order_acquire);
+		return iterator(p);
+	}
+
+	pair<iterator, bool> insert(const value_type& value)
+	{
+		return emplace(value.first, value.second);
+	}
+
+	/**
+	 * 以 key 构造键，args 构造值(可以没有参数，也可以有多个)
+	 * 键已存在时不插入，返回已有的元素
+	 * 与其他线程竞争插入同一个键而失败时，已构造的节点被析构，其内存留在 arena 中
+	 */
+	template<class... Args>
+	pair<iterator, bool> emplace(const K& key, Args&&... args)
+	{
+		link* preds[max_height];
+		node* succs[max_height];
+		if (node* found = __find_position(key, preds, succs))
+			return pair<iterator, bool>(iterator(found), false);
+
+		const int h = __random_height();
+		node* n = __create_node(h, key, std::forward<Args>(args)...);
+
+		// 第 0 层的 CAS 成功即表示插入成功
+		for (;;)
+		{
+			n->next()[0].store(succs[0], std::memory_order_relaxed);
+			if (preds[0]->compare_exchange_strong(succs[0], n, std::memory_order_release, std::memory_order_relaxed))
+				break;
+			if (node* found = __find_position(key, preds, succs))
+			{
+				n->~node();
+				return pair<iterator, bool>(iterator(found), false);
+			}
+		}
+
+		__raise_levels(h);
+		for (int level = 1; level < h; ++level)
+		{
+			for (;;)
+			{
+				n->next()[level].store(succs[level], std::memory_order_relaxed);
+				if (preds[level]->compare_exchange_strong(succs[level], n, std::memory_order_release, std::memory_order_relaxed))
+					break;
+				__find_position(key, preds, succs);
+			}
+		}
+		count.fetch_add(1, std::memory_order_relaxed);
+		return pair<iterator, bool>(iterator(n), true);
+	}
+
+private:
+	template<class... Args>
+	node* __create_node(int h, Args&&... args)
+	{
+		void* p = pool().allocate(sizeof(node) + h * sizeof(link), alignof(node));
+		node* n = ::new (p) node(h, std::forward<Args>(args)...);
+		for (int level = 0; level < h; ++level) ::new (n->next() + level) link(nullptr);
+		return n;
+	}
+
+	// 每层的前驱链接(指向前驱节点中该层的后继指针)与后继，键已存在时返回该节点
+	node* __find_position(const K& key, link** preds, node** succs)const
+	{
+		link* prev = const_cast<link*>(head);
+		const int top = levels.load(std::memory_order_acquire);
+		for (int level = max_height - 1; level >= top; --level)
+		{
+			preds[level] = const_cast<link*>(head) + level;
+			succs[level] = nullptr;
+		}
+		for (int level = top - 1; level >= 0; --level)
+		{
+			node* cur = prev[level].load(std::memory_order_acquire);
+			while (cur != nullptr && comp()(cur->value.first, key))
+			{
+				prev = cur->next();
+				cur = prev[level].load(std::memory_order_acquire);
+			}
+			preds[level] = prev + level;
+			succs[level] = cur;
+		}
+		node* cur = succs[0];
+		return cur != nullptr && !comp()(key, cur->value.first) ? cur : nullptr;
+	}
+
+	node* __lower_bound(const K& key)const
+	{
+		const link* prev = head;
+		node* cur = nullptr;
+		for (int level = levels.load(std::memory_order_acquire) - 1; level >= 0; --level)
+		{
+			cur = prev[level].load(std::memory_order_acquire);
+			while (cur != nullptr && comp()(cur->value.first, key))
+			{
+				prev = cur->next();
+				cur = prev[level].load(std::memory_order_acquire);
+			}
+		}
+		return cur;
+	}
+
+	void __raise_levels(int h)noexcept
+	{
+		int cur = levels.load(std::memory_order_relaxed);
+		while (cur < h && !levels.compare_exchange_weak(cur, h, std::memory_order_release, std::memory_order_relaxed)) {}
+	}
+
+	// 每个线程一个 xorshift 生成器，以线程局部变量的地址作为种子的一部分
+	static int __random_height()noexcept
+	{
+		thread_local uint64_t state = 0;
+		if (state == 0)
+			state = (reinterpret_cast<uintptr_t>(&state) * 0x9e3779b97f4a7c15ULL) | 1;
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		int h = 1 + countr_zero(state) / 2;
+		return h < max_height ? h : max_height;
+	}
+};
+
+SX_NAMESPACE_END
+#endif	// end define _SX_SKIPLIST_H_
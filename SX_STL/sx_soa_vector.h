@@ -0,0 +1,458 @@
+﻿/**************************************************
+ * @brief   : 按列存储的 vector (structure of arrays)
+ * @file    : sx_soa_vector.h
+ * @author  : 宋旭
+ * @date    : 2026年10月18日，19:10:37
+ **************************************************/
+
+#ifndef _SX_SOA_VECTOR_H_
+#define _SX_SOA_VECTOR_H_
+#include <cstddef>			// ptrdiff_t
+#include <memory>			// uninitialized_move, destroy
+#include <new>				// operator new, align_val_t
+#include <span>				// span
+#include <stdexcept>		// out_of_range
+#include <tuple>			// tuple, get, apply
+#include <type_traits>		// is_nothrow_move_constructible
+#include <utility>			// index_sequence, move, forward
+#include "sx_iterator.h"
+#include "sx_trace.h"
+
+SX_NAMESPACE_BEGIN
+
+namespace detail {
+	// soa_vector 的列起始地址按缓存行对齐，方便编译器向量化
+	constexpr size_t __soa_column_align = 64;
+
+	constexpr size_t __soa_align_up(size_t n, size_t align)noexcept
+	{
+		return (n + align - 1) & ~(align - 1);
+	}
+
+	// 移动构造不抛出异常或无法复制时移动，否则复制，源元素保持不变以便回滚
+	template<class T>
+	inline T* __soa_uninitialized_move_if_noexcept_n(T* first, size_t n, T* dest)
+	{
+		if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>)
+			return std::uninitialized_move_n(first, n, dest).second;
+		else
+			return std::uninitialized_copy_n(first, n, dest);
+	}
+
+	/**
+	 * soa_vector 的随机访问迭代器
+	 * 保存各列的起始地址和当前下标，解引用得到由各列元素引用组成的 tuple
+	 */
+	template<bool Const, class... Ts>
+	class __soa_iterator : public iterator<random_access_iterator_tag, std::tuple<Ts...>, ptrdiff_t, void,
+		std::conditional_t<Const, std::tuple<const Ts&...>, std::tuple<Ts&...>>>
+	{
+		template<bool, class...> friend class __soa_iterator;
+
+	public:
+		using reference			= std::conditional_t<Const, std::tuple<const Ts&...>, std::tuple<Ts&...>>;
+		using difference_type	= ptrdiff_t;
+		using columns_type		= std::conditional_t<Const, std::tuple<const Ts*...>, std::tuple<Ts*...>>;
+		using self				= __soa_iterator;
+
+	private:
+		columns_type	columns{};
+		size_t			index = 0;
+
+	public:
+		__soa_iterator() = default;
+		__soa_iterator(const columns_type& cols, size_t i)noexcept : columns(cols), index(i) {}
+
+		// 非 const 迭代器可转换为 const 迭代器
+		template<bool C = Const, class = std::enable_if_t<C>>
+		__soa_iterator(const __soa_iterator<false, Ts...>& rhs)noexcept
+			: columns(std::apply([](auto*... p) { return columns_type(p...); }, rhs.columns)), index(rhs.index) {}
+
+		reference operator*()const noexcept
+		{
+			return std::apply([this](auto*... p) { return reference(p[index]...); }, columns);
+		}
+
+		reference operator[](difference_type n)const noexcept
+		{
+			return *(*this + n);
+		}
+
+		size_t position()const noexcept { return index; }
+
+		self& operator++()noexcept { ++index; return *this; }
+		self operator++(int)noexcept { auto temp = *this; ++index; return temp; }
+		self& operator--()noexcept { --index; return *this; }
+		self operator--(int)noexcept { auto temp = *this; --index; return temp; }
+
+		self& operator+=(difference_type n)noexcept { index += n; return *this; }
+		self& operator-=(difference_type n)noexcept { index -= n; return *this; }
+		self operator+(difference_type n)const noexcept { auto temp = *this; return temp += n; }
+		self operator-(difference_type n)const noexcept { auto temp = *this; return temp -= n; }
+		friend self operator+(difference_type n, const self& it)noexcept { return it + n; }
+
+		difference_type operator-(const self& rhs)const noexcept
+		{
+			return static_cast<difference_type>(index) - static_cast<difference_type>(rhs.index);
+		}
+
+		bool operator==(const self& rhs)const noexcept { return index == rhs.index; }
+		bool operator!=(const self& rhs)const noexcept { return index != rhs.index; }
+		bool operator<(const self& rhs)const noexcept { return index < rhs.index; }
+		bool operator<=(const self& rhs)const noexcept { return index <= rhs.index; }
+		bool operator>(const self& rhs)const noexcept { return index > rhs.index; }
+		bool operator>=(const self& rhs)const noexcept { return index >= rhs.index; }
+	};
+}
+
+
+/**
+ * soa_vector
+ * 每个字段存放在各自的连续数组中，只访问少数字段的循环不会把其他字段读入缓存
+ * 所有列位于同一块内存中，每列起始地址按 64 字节对齐
+ * column<I>() 返回第 I 列的 span，适合逐列处理
+ * 迭代器解引用得到 tuple<Ts&...>，可使用结构化绑定
+ */
+template<class... Ts>
+class soa_vector
+{
+	static_assert(sizeof...(Ts) > 0, "soa_vector requires at least one column");
+	static_assert(((alignof(Ts) <= detail::__soa_column_align) && ...), "soa_vector column alignment is too large");
+
+public:
+	using value_type				= std::tuple<Ts...>;
+	using reference					= std::tuple<Ts&...>;
+	using const_reference			= std::tuple<const Ts&...>;
+	using size_type					= size_t;
+	using difference_type			= ptrdiff_t;
+	using iterator					= detail::__soa_iterator<false, Ts...>;
+	using const_iterator			= detail::__soa_iterator<true, Ts...>;
+
+	using self						= soa_vector<Ts...>;
+
+	template<size_t I>
+	using column_type				= std::tuple_element_t<I, std::tuple<Ts...>>;
+
+	static constexpr size_t column_count = sizeof...(Ts);
+
+private:
+	using index_sequence = std::index_sequence_for<Ts...>;
+
+	void*				block	= nullptr;
+	std::tuple<Ts*...>	columns{};
+	size_type			count	= 0;
+	size_type			cap		= 0;
+
+public:
+	soa_vector() = default;
+
+	// 以下构造函数委托默认构造，构造元素失败时由析构函数释放已分配的内存
+
+	explicit soa_vector(size_type n) : soa_vector()
+	{
+		resize(n);
+	}
+
+	soa_vector(const self& rhs) : soa_vector()
+	{
+		reserve(rhs.count);
+		__construct_columns(
+			[&](auto index) { std::uninitialized_copy_n(std::get<index>(rhs.columns), rhs.count, std::get<index>(columns)); },
+			[&](auto index) { std::destroy_n(std::get<index>(columns), rhs.count); });
+		count = rhs.count;
+	}
+
+	soa_vector(self&& rhs)noexcept
+		: block(rhs.block), columns(rhs.columns), count(rhs.count), cap(rhs.cap)
+	{
+		rhs.block = nullptr;
+		rhs.columns = {};
+		rhs.count = rhs.cap = 0;
+	}
+
+	self& operator=(const self& rhs)
+	{
+		if (this != &rhs)
+		{
+			self temp(rhs);
+			swap(temp);
+		}
+		return *this;
+	}
+
+	self& operator=(self&& rhs)noexcept
+	{
+		if (this != &rhs)
+		{
+			self temp(std::move(rhs));
+			swap(temp);
+		}
+		return *this;
+	}
+
+	~soa_vector()
+	{
+		clear();
+		__deallocate(block);
+	}
+
+	// 迭代器相关
+	iterator begin()noexcept { return iterator(columns, 0); }
+	const_iterator begin()const noexcept { return const_iterator(__const_columns(), 0); }
+	const_iterator cbegin()const noexcept { return begin(); }
+	iterator end()noexcept { return iterator(columns, count); }
+	const_iterator end()const noexcept { return const_iterator(__const_columns(), count); }
+	const_iterator cend()const noexcept { return end(); }
+
+	// 容量相关
+	SX_NODISCARD bool empty()const noexcept { return count == 0; }
+	size_type size()const noexcept { return count; }
+	size_type capacity()const noexcept { return cap; }
+
+	// 元素访问
+	reference operator[](size_type n)noexcept { return begin()[n]; }
+	const_reference operator[](size_type n)const noexcept { return begin()[n]; }
+
+	reference at(size_type n)
+	{
+		if (n >= count) throw std::out_of_range("soa_vector::at");
+		return (*this)[n];
+	}
+
+	const_reference at(size_type n)const
+	{
+		if (n >= count) throw std::out_of_range("soa_vector::at");
+		return (*this)[n];
+	}
+
+	reference front()noexcept { return (*this)[0]; }
+	const_reference front()const noexcept { return (*this)[0]; }
+	reference back()noexcept { return (*this)[count - 1]; }
+	const_reference back()const noexcept { return (*this)[count - 1]; }
+
+	// 第 I 列的起始地址
+	template<size_t I>
+	column_type<I>* data()noexcept { return std::get<I>(columns); }
+
+	template<size_t I>
+	const column_type<I>* data()const noexcept { return std::get<I>(columns); }
+
+	// 第 I 列
+	template<size_t I>
+	std::span<column_type<I>> column()noexcept { return std::span<column_type<I>>(data<I>(), count); }
+
+	template<size_t I>
+	std::span<const column_type<I>> column()const noexcept { return std::span<const column_type<I>>(data<I>(), count); }
+
+	// 修改相关
+	void reserve(size_type n)
+	{
+		if (n > cap) __reallocate(n);
+	}
+
+	void shrink_to_fit()
+	{
+		if (cap > count) __reallocate(count);
+	}
+
+	void push_back(const Ts&... values)
+	{
+		emplace_back(values...);
+	}
+
+	void push_back(Ts&&... values)
+	{
+		emplace_back(std::move(values)...);
+	}
+
+	// 每个参数构造对应列的一个元素
+	template<class... Args>
+	reference emplace_back(Args&&... args)
+	{
+		static_assert(sizeof...(Args) == sizeof...(Ts), "soa_vector::emplace_back needs one argument per column");
+		if (count == cap)
+		{
+			// 参数可能引用本容器中的元素，扩容前先构造到临时对象中
+			value_type temp(std::forward<Args>(args)...);
+			__reallocate(__next_capacity(count + 1));
+			std::apply([this](Ts&... values) { __construct_at(count, std::move(values)...); }, temp);
+		}
+		else
+		{
+			__construct_at(count, std::forward<Args>(args)...);
+		}
+		++count;
+		return back();
+	}
+
+	void pop_back()noexcept
+	{
+		--count;
+		__for_each_column([&](auto* p, auto) { std::destroy_at(p + count); });
+	}
+
+	void resize(size_type n)
+	{
+		if (n > cap) __reallocate(n);
+		if (n > count)
+		{
+			__construct_columns(
+				[&](auto index) { std::uninitialized_value_construct_n(std::get<index>(columns) + count, n - count); },
+				[&](auto index) { std::destroy_n(std::get<index>(columns) + count, n - count); });
+		}
+		else
+		{
+			__for_each_column([&](auto* p, auto) { std::destroy_n(p + n, count - n); });
+		}
+		count = n;
+	}
+
+	// 用末尾元素覆盖第 n 个元素后删除末尾，O(1)，不保持顺序
+	void swap_erase(size_type n)
+	{
+		if (n != count - 1)
+			__for_each_column([&](auto* p, auto) { p[n] = std::move(p[count - 1]); });
+		pop_back();
+	}
+
+	void clear()noexcept
+	{
+		__for_each_column([&](auto* p, auto) { std::destroy_n(p, count); });
+		count = 0;
+	}
+
+	void swap(self& rhs)noexcept
+	{
+		std::swap(block, rhs.block);
+		std::swap(columns, rhs.columns);
+		std::swap(count, rhs.count);
+		std::swap(cap, rhs.cap);
+	}
+
+private:
+	std::tuple<const Ts*...> __const_columns()const noexcept
+	{
+		return std::apply([](auto*... p) { return std::tuple<const Ts*...>(p...); }, columns);
+	}
+
+	// 对每一列调用 f(列起始地址, integral_constant<size_t, I>)
+	template<class Function>
+	void __for_each_column(Function&& f)
+	{
+		__for_each_column(f, columns, index_sequence());
+	}
+
+	template<class Function, size_t... I>
+	static void __for_each_column(Function& f, std::tuple<Ts*...>& cols, std::index_sequence<I...>)
+	{
+		(f(std::get<I>(cols), std::integral_constant<size_t, I>()), ...);
+	}
+
+	/**
+	 * 依次对每一列调用 construct(integral_constant<size_t, I>)
+	 * 某一列抛出异常时，对之前已完成的列调用 rollback 后重新抛出，每一列自身由 construct 保证不残留元素
+	 */
+	template<class Construct, class Rollback>
+	static void __construct_columns(Construct&& construct, Rollback&& rollback)
+	{
+		__construct_columns(construct, rollback, index_sequence());
+	}
+
+	template<class Construct, class Rollback, size_t... I>
+	static void __construct_columns(Construct& construct, Rollback& rollback, std::index_sequence<I...>)
+	{
+		size_t done = 0;
+		try
+		{
+			((construct(std::integral_constant<size_t, I>()), ++done), ...);
+		}
+		catch (...)
+		{
+			((I < done ? rollback(std::integral_constant<size_t, I>()) : void()), ...);
+			throw;
+		}
+	}
+
+	template<class... Args>
+	void __construct_at(size_type n, Args&&... args)
+	{
+		std::tuple<Args&&...> refs(std::forward<Args>(args)...);
+		__construct_columns(
+			[&](auto index) {
+				using T = column_type<index>;
+				::new (static_cast<void*>(std::get<index>(columns) + n)) T(std::get<index>(std::move(refs)));
+			},
+			[&](auto index) { std::destroy_at(std::get<index>(columns) + n); });
+	}
+
+	size_type __next_capacity(size_type need)const noexcept
+	{
+		size_type n = cap < 8 ? 8 : cap * 2;
+		return n < need ? need : n;
+	}
+
+	// 计算容量为 n 时每一列的偏移量及总字节数
+	static size_t __layout(size_type n, size_t (&offsets)[sizeof...(Ts)])noexcept
+	{
+		size_t bytes = 0;
+		size_t i = 0;
+		((offsets[i++] = detail::__soa_align_up(bytes, detail::__soa_column_align),
+			bytes = offsets[i - 1] + n * sizeof(Ts)), ...);
+		return bytes;
+	}
+
+	static void __deallocate(void* p)noexcept
+	{
+		if (p != nullptr) ::operator delete(p, std::align_val_t(detail::__soa_column_align));
+	}
+
+	void __reallocate(size_type n)
+	{
+		SX_SCOPED_TIMER("soa_vector::reallocate");
+		size_t offsets[sizeof...(Ts)];
+		size_t bytes = __layout(n, offsets);
+		void* new_block = n == 0 ? nullptr : ::operator new(bytes, std::align_val_t(detail::__soa_column_align));
+
+		std::tuple<Ts*...> new_columns = __columns_at(new_block, offsets, index_sequence());
+		// 所有列都构造成功后才销毁旧元素，失败时原容器不变(移动构造会抛出异常的不可复制类型除外)
+		try
+		{
+			__construct_columns(
+				[&](auto index) {
+					detail::__soa_uninitialized_move_if_noexcept_n(std::get<index>(columns), count, std::get<index>(new_columns));
+				},
+				[&](auto index) {
+					// 已被移动走的列移回原处，移动构造不抛出异常
+					auto* src = std::get<index>(columns);
+					auto* dst = std::get<index>(new_columns);
+					if constexpr (std::is_nothrow_move_constructible_v<column_type<index>>)
+					{
+						std::destroy_n(src, count);
+						std::uninitialized_move_n(dst, count, src);
+					}
+					std::destroy_n(dst, count);
+				});
+		}
+		catch (...)
+		{
+			__deallocate(new_block);
+			throw;
+		}
+
+		__for_each_column([&](auto* p, auto) { std::destroy_n(p, count); });
+		__deallocate(block);
+		block = new_block;
+		columns = new_columns;
+		cap = n;
+	}
+
+	template<size_t... I>
+	static std::tuple<Ts*...> __columns_at(void* base, const size_t (&offsets)[sizeof...(Ts)], std::index_sequence<I...>)noexcept
+	{
+		if (base == nullptr) return std::tuple<Ts*...>();
+		return std::tuple<Ts*...>(reinterpret_cast<column_type<I>*>(static_cast<char*>(base) + offsets[I])...);
+	}
+};
+
+SX_NAMESPACE_END
+#endif	// end define _SX_SOA_VECTOR_H_
@@ -0,0 +1,493 @@
+﻿/**************************************************
+ * @brief   : 分块的 string_builder 与 rope
+ * @file    : sx_string_builder.h
+ * @author  : 宋旭
+ * @date    : 2026年10月19日，02:41:27
+ **************************************************/
+
+#ifndef _SX_STRING_BUILDER_H_
+#define _SX_STRING_BUILDER_H_
+#include <cstring>			// memcpy
+#include <memory>			// shared_ptr, make_shared
+#include <new>				// operator new
+#include <stdexcept>		// out_of_range
+#include <string>			// string
+#include <string_view>		// string_view
+#include <utility>			// move, exchange, pair
+#include <vector>			// vector
+#include <sys/uio.h>		// iovec, writev
+#include "sx_arena.h"
+
+SX_NAMESPACE_BEGIN
+
+/**
+ * string_builder
+ * 追加的内容写入由固定大小的块组成的链表，块写满时申请新块，已写入的内容从不移动或复制
+ * 单次追加超过块大小时，剩余部分放入一个恰好够大的块
+ *
+ * 块默认使用全局 operator new；以 arena 构造时从 arena 中分配，clear 与析构都不归还内存，
+ * 内存随 arena 释放，适合与请求同生命周期的 arena 一起使用
+ *
+ * 输出时不需要拼接成连续的字符串：to_iovec 给出每个块的 iovec，可直接交给 writev，
+ * for_each_chunk 按顺序访问每个块
+ * prepare / commit 直接在末尾的块中写入，例如 std::to_chars(p, p + 32, value)
+ */
+class string_builder
+{
+public:
+	using size_type = size_t;
+
+	static constexpr size_t default_chunk_size = 16 * 1024;
+
+private:
+	struct alignas(std::max_align_t) chunk
+	{
+		chunk*	next;
+		size_t	size;
+		size_t	capacity;
+
+		char* data()noexcept { return reinterpret_cast<char*>(this + 1); }
+		const char* data()const noexcept { return reinterpret_cast<const char*>(this + 1); }
+	};
+
+	chunk*	head		= nullptr;
+	chunk*	tail		= nullptr;
+	size_t	total		= 0;
+	size_t	chunks		= 0;
+	size_t	chunk_size;
+	arena*	pool		= nullptr;
+
+public:
+	explicit string_builder(size_t chunk_bytes = default_chunk_size)
+		: chunk_size(chunk_bytes == 0 ? default_chunk_size : chunk_bytes) {}
+
+	explicit string_builder(arena& a, size_t chunk_bytes = default_chunk_size)
+		: chunk_size(chunk_bytes == 0 ? default_chunk_size : chunk_bytes), pool(&a) {}
+
+	string_builder(string_builder&& rhs)noexcept
+		: head(std::exchange(rhs.head, nullptr)), tail(std::exchange(rhs.tail, nullptr)),
+		total(std::exchange(rhs.total, 0)), chunks(std::exchange(rhs.chunks, 0)),
+		chunk_size(rhs.chunk_size), pool(rhs.pool) {}
+
+	string_builder& operator=(string_builder&& rhs)noexcept
+	{
+		if (this != &rhs)
+		{
+			__release();
+			head = std::exchange(rhs.head, nullptr);
+			tail = std::exchange(rhs.tail, nullptr);
+			total = std::exchange(rhs.total, 0);
+			chunks = std::exchange(rhs.chunks, 0);
+			chunk_size = rhs.chunk_size;
+			pool = rhs.pool;
+		}
+		return *this;
+	}
+
+	string_builder(const string_builder&) = delete;
+	string_builder& operator=(const string_builder&) = delete;
+
+	~string_builder()
+	{
+		__release();
+	}
+
+	string_builder& append(const char* s, size_t n)
+	{
+		while (n > 0)
+		{
+			if (tail == nullptr || tail->size == tail->capacity) __add_chunk(n);
+			size_t k = tail->capacity - tail->size;
+			if (k > n) k = n;
+			std::memcpy(tail->data() + tail->size, s, k);
+			tail->size += k;
+			total += k;
+			s += k;
+			n -= k;
+		}
+		return *this;
+	}
+
+	string_builder& append(std::string_view s) { return append(s.data(), s.size()); }
+
+	string_builder& append(size_t n, char c)
+	{
+		while (n > 0)
+		{
+			if (tail == nullptr || tail->size == tail->capacity) __add_chunk(n);
+			size_t k = tail->capacity - tail->size;
+			if (k > n) k = n;
+			std::memset(tail->data() + tail->size, c, k);
+			tail->size += k;
+			total += k;
+			n -= k;
+		}
+		return *this;
+	}
+
+	void push_back(char c)
+	{
+		if (tail == nullptr || tail->size == tail->capacity) __add_chunk(1);
+		tail->data()[tail->size++] = c;
+		++total;
+	}
+
+	string_builder& operator+=(std::string_view s) { return append(s); }
+	string_builder& operator+=(char c) { push_back(c); return *this; }
+
+	// 返回末尾至少 n 个字节的连续空间，写入后以 commit 确认实际写入的字节数
+	// 当前块剩余空间不足时开始一个新块，旧块剩余的空间不再使用
+	char* prepare(size_t n)
+	{
+		if (tail == nullptr || tail->capacity - tail->size < n) __add_chunk(n);
+		return tail->data() + tail->size;
+	}
+
+	void commit(size_t n)noexcept
+	{
+		tail->size += n;
+		total += n;
+	}
+
+	size_type size()const noexcept { return total; }
+	SX_NODISCARD bool empty()const noexcept { return total == 0; }
+	size_type chunk_count()const noexcept { return chunks; }
+
+	void clear()noexcept
+	{
+		__release();
+		head = tail = nullptr;
+		total = 0;
+		chunks = 0;
+	}
+
+	template<class Function>
+	void for_each_chunk(Function f)const
+	{
+		for (const chunk* c = head; c != nullptr; c = c->next)
+		{
+			if (c->size != 0) f(std::string_view(c->data(), c->size));
+		}
+	}
+
+	// 每个非空块一个 iovec，指向 string_builder 内部，修改或析构后失效
+	std::vector<iovec> to_iovec()const
+	{
+		std::vector<iovec> iov;
+		iov.reserve(chunks);
+		for_each_chunk([&iov](std::string_view s) {
+			iov.push_back(iovec{ const_cast<char*>(s.data()), s.size() });
+		});
+		return iov;
+	}
+
+	void copy_to(char* out)const
+	{
+		for_each_chunk([&out](std::string_view s) {
+			std::memcpy(out, s.data(), s.size());
+			out += s.size();
+		});
+	}
+
+	std::string str()const
+	{
+		std::string s(total, '\0');
+		copy_to(s.data());
+		return s;
+	}
+
+	void swap(string_builder& rhs)noexcept
+	{
+		std::swap(head, rhs.head);
+		std::swap(tail, rhs.tail);
+		std::swap(total, rhs.total);
+		std::swap(chunks, rhs.chunks);
+		std::swap(chunk_size, rhs.chunk_size);
+		std::swap(pool, rhs.pool);
+	}
+
+private:
+	void __add_chunk(size_t need)
+	{
+		const size_t capacity = need > chunk_size ? need : chunk_size;
+		const size_t bytes = sizeof(chunk) + capacity;
+		void* raw = pool != nullptr ? pool->allocate(bytes, alignof(chunk)) : ::operator new(bytes);
+		chunk* c = ::new (raw) chunk{ nullptr, 0, capacity };
+		if (tail != nullptr) tail->next = c;
+		else head = c;
+		tail = c;
+		++chunks;
+	}
+
+	void __release()noexcept
+	{
+		if (pool != nullptr) return;
+		chunk* c = head;
+		while (c != nullptr)
+		{
+			chunk* next = c->next;
+			::operator delete(static_cast<void*>(c), sizeof(chunk) + c->capacity);
+			c = next;
+		}
+	}
+};
+
+inline void swap(string_builder& lhs, string_builder& rhs)noexcept
+{
+	lhs.swap(rhs);
+}
+
+
+/**
+ * rope
+ * 不可变的字符串，表示为 AVL 树：叶子引用一段共享的字符串缓冲区，内部结点表示左右两部分的拼接
+ * 结点一经创建不再修改，多个 rope 之间共享子树，复制 rope 只复制一个指针
+ *
+ * 拼接(operator+)沿较高一棵树的边缘下降到高度相当处再合并，O(log n)
+ * substr 与 split 沿路径拆分，只创建 O(log n) 个新结点，叶子的缓冲区不复制
+ * 两段都很短的拼接直接合并为一个新叶子，避免逐字符追加产生大量的小结点
+ */
+namespace detail {
+	struct __rope_node
+	{
+		using ptr = std::shared_ptr<const __rope_node>;
+
+		ptr									left;
+		ptr									right;
+		std::shared_ptr<const std::string>	buffer;		// 只有叶子使用
+		size_t								offset	= 0;
+		size_t								length	= 0;
+		int									height	= 0;	// 叶子为 0
+
+		bool is_leaf()const noexcept { return left == nullptr; }
+		std::string_view text()const noexcept { return std::string_view(*buffer).substr(offset, length); }
+	};
+
+	using __rope_ptr = __rope_node::ptr;
+
+	constexpr size_t __rope_merge_limit = 128;
+
+	inline int __rope_height(const __rope_ptr& p)noexcept { return p == nullptr ? -1 : p->height; }
+	inline size_t __rope_length(const __rope_ptr& p)noexcept { return p == nullptr ? 0 : p->length; }
+
+	inline __rope_ptr __rope_leaf(std::shared_ptr<const std::string> buffer, size_t offset, size_t length)
+	{
+		if (length == 0) return nullptr;
+		auto n = std::make_shared<__rope_node>();
+		n->buffer = std::move(buffer);
+		n->offset = offset;
+		n->length = length;
+		return n;
+	}
+
+	inline __rope_ptr __rope_make(__rope_ptr left, __rope_ptr right)
+	{
+		auto n = std::make_shared<__rope_node>();
+		n->length = left->length + right->length;
+		n->height = (left->height > right->height ? left->height : right->height) + 1;
+		n->left = std::move(left);
+		n->right = std::move(right);
+		return n;
+	}
+
+	// 左右高度差不超过 2 时恢复平衡
+	inline __rope_ptr __rope_balance(__rope_ptr left, __rope_ptr right)
+	{
+		const int hl = __rope_height(left);
+		const int hr = __rope_height(right);
+		if (hl > hr + 1)
+		{
+			if (__rope_height(left->left) >= __rope_height(left->right))
+				return __rope_make(left->left, __rope_make(left->right, std::move(right)));
+			return __rope_make(__rope_make(left->left, left->right->left),
+				__rope_make(left->right->right, std::move(right)));
+		}
+		if (hr > hl + 1)
+		{
+			if (__rope_height(right->right) >= __rope_height(right->left))
+				return __rope_make(__rope_make(std::move(left), right->left), right->right);
+			return __rope_make(__rope_make(std::move(left), right->left->left),
+				__rope_make(right->left->right, right->right));
+		}
+		return __rope_make(std::move(left), std::move(right));
+	}
+
+	inline __rope_ptr __rope_join(__rope_ptr left, __rope_ptr right)
+	{
+		if (left == nullptr) return right;
+		if (right == nullptr) return left;
+
+		if (left->is_leaf() && right->is_leaf() && left->length + right->length <= __rope_merge_limit)
+		{
+			auto s = std::make_shared<std::string>();
+			s->reserve(left->length + right->length);
+			s->append(left->text());
+			s->append(right->text());
+			const size_t n = s->size();
+			return __rope_leaf(std::move(s), 0, n);
+		}
+
+		if (left->height > right->height + 1)
+			return __rope_balance(left->left, __rope_join(left->right, std::move(right)));
+		if (right->height > left->height + 1)
+			return __rope_balance(__rope_join(std::move(left), right->left), right->right);
+		return __rope_make(std::move(left), std::move(right));
+	}
+
+	// 拆分为前 pos 个字符与其余部分
+	inline std::pair<__rope_ptr, __rope_ptr> __rope_split(const __rope_ptr& p, size_t pos)
+	{
+		if (p == nullptr) return { nullptr, nullptr };
+		if (pos == 0) return { nullptr, p };
+		if (pos >= p->length) return { p, nullptr };
+		if (p->is_leaf())
+		{
+			return { __rope_leaf(p->buffer, p->offset, pos),
+				__rope_leaf(p->buffer, p->offset + pos, p->length - pos) };
+		}
+
+		const size_t left_length = p->left->length;
+		if (pos <= left_length)
+		{
+			auto parts = __rope_split(p->left, pos);
+			return { std::move(parts.first), __rope_join(std::move(parts.second), p->right) };
+		}
+		auto parts = __rope_split(p->right, pos - left_length);
+		return { __rope_join(p->left, std::move(parts.first)), std::move(parts.second) };
+	}
+
+	template<class Function>
+	void __rope_for_each(const __rope_node* p, Function& f)
+	{
+		while (p != nullptr)
+		{
+			if (p->is_leaf())
+			{
+				f(p->text());
+				return;
+			}
+			__rope_for_each(p->left.get(), f);
+			p = p->right.get();
+		}
+	}
+}
+
+class rope
+{
+public:
+	using size_type = size_t;
+
+private:
+	detail::__rope_ptr root;
+
+	explicit rope(detail::__rope_ptr p)noexcept : root(std::move(p)) {}
+
+public:
+	rope() = default;
+
+	// 接管字符串，不复制
+	rope(std::string s)
+	{
+		const size_t n = s.size();
+		root = detail::__rope_leaf(std::make_shared<const std::string>(std::move(s)), 0, n);
+	}
+
+	rope(std::string_view s) : rope(std::string(s)) {}
+	rope(const char* s) : rope(std::string(s)) {}
+
+	size_type size()const noexcept { return detail::__rope_length(root); }
+	size_type length()const noexcept { return size(); }
+	SX_NODISCARD bool empty()const noexcept { return root == nullptr; }
+
+	// 树高，用于检查平衡
+	int depth()const noexcept { return root == nullptr ? 0 : root->height; }
+
+	char operator[](size_t i)const noexcept
+	{
+		const detail::__rope_node* p = root.get();
+		while (!p->is_leaf())
+		{
+			if (i < p->left->length) p = p->left.get();
+			else
+			{
+				i -= p->left->length;
+				p = p->right.get();
+			}
+		}
+		return (*p->buffer)[p->offset + i];
+	}
+
+	char at(size_t i)const
+	{
+		if (i >= size()) throw std::out_of_range("rope::at: index out of range");
+		return (*this)[i];
+	}
+
+	// pos 超过长度时抛出 out_of_range，n 超出末尾时截断
+	rope substr(size_t pos, size_t n = std::string::npos)const
+	{
+		if (pos > size()) throw std::out_of_range("rope::substr: position out of range");
+		auto tail = detail::__rope_split(root, pos).second;
+		return rope(detail::__rope_split(tail, n).first);
+	}
+
+	// 前 pos 个字符与其余部分
+	std::pair<rope, rope> split(size_t pos)const
+	{
+		if (pos > size()) throw std::out_of_range("rope::split: position out of range");
+		auto parts = detail::__rope_split(root, pos);
+		return { rope(std::move(parts.first)), rope(std::move(parts.second)) };
+	}
+
+	rope insert(size_t pos, const rope& r)const
+	{
+		auto parts = split(pos);
+		return rope(detail::__rope_join(detail::__rope_join(std::move(parts.first.root), r.root), std::move(parts.second.root)));
+	}
+
+	rope erase(size_t pos, size_t n = std::string::npos)const
+	{
+		if (pos > size()) throw std::out_of_range("rope::erase: position out of range");
+		auto parts = detail::__rope_split(root, pos);
+		return rope(detail::__rope_join(std::move(parts.first), detail::__rope_split(parts.second, n).second));
+	}
+
+	rope& operator+=(const rope& rhs)
+	{
+		root = detail::__rope_join(std::move(root), rhs.root);
+		return *this;
+	}
+
+	friend rope operator+(const rope& lhs, const rope& rhs)
+	{
+		return rope(detail::__rope_join(lhs.root, rhs.root));
+	}
+
+	// 按顺序访问每一段连续的文本
+	template<class Function>
+	void for_each_chunk(Function f)const
+	{
+		detail::__rope_for_each(root.get(), f);
+	}
+
+	std::string str()const
+	{
+		std::string s;
+		s.reserve(size());
+		for_each_chunk([&s](std::string_view piece) { s.append(piece); });
+		return s;
+	}
+
+	void swap(rope& rhs)noexcept
+	{
+		root.swap(rhs.root);
+	}
+};
+
+inline void swap(rope& lhs, rope& rhs)noexcept
+{
+	lhs.swap(rhs);
+}
+
+SX_NAMESPACE_END
+#endif	// end define _SX_STRING_BUILDER_H_
@@ -0,0 +1,27 @@
+﻿/**************************************************
+ * @brief   : 作用域计时宏 SX_SCOPED_TIMER
+ * @file    : sx_trace.h
+ * @author  : 宋旭
+ * @date    : 2026年10月19日，03:41:27
+ **************************************************/
+
+#ifndef _SX_TRACE_H_
+#define _SX_TRACE_H_
+#include "sx_def.h"
+
+// 将所在作用域的耗时记录到名为 name 的全局直方图中(见 sx_latency_histogram.h)
+// 只有定义了 SX_ENABLE_TRACING 时才生效，否则展开为空语句
+// 每个使用处以局部静态变量缓存直方图，只在第一次执行时按名字查找
+// 变量名以 __COUNTER__ 区分，同一行中可以有多个计时器
+#ifdef SX_ENABLE_TRACING
+#include "sx_latency_histogram.h"
+
+#define SX_SCOPED_TIMER(name) SX_SCOPED_TIMER_IMPL(name, __COUNTER__)
+#define SX_SCOPED_TIMER_IMPL(name, id)																\
+	static ::sx::latency_histogram& SX_CONCAT(sx_trace_histogram_, id) = ::sx::trace_histogram(name);	\
+	::sx::scoped_timer SX_CONCAT(sx_trace_timer_, id)(SX_CONCAT(sx_trace_histogram_, id))
+#else
+#define SX_SCOPED_TIMER(name) ((void)0)
+#endif // SX_ENABLE_TRACING
+
+#endif	// end define _SX_TRACE_H_
@@ -0,0 +1,343 @@
+﻿/**************************************************
+ * @brief   : tuple 的实现
+ * @file    : sx_tuple.h
+ * @author  : 宋旭
+ * @date    : 2026年10月18日，20:31:44
+ **************************************************/
+
+#ifndef _SX_TUPLE_H_
+#define _SX_TUPLE_H_
+#include <cstddef>			// size_t
+#include <functional>		// invoke, reference_wrapper
+#include <tuple>			// tuple_size, tuple_element
+#include <type_traits>		// is_empty, is_final, decay_t
+#include <utility>			// index_sequence, forward, move
+#include "sx_type_traits.h"
+
+SX_NAMESPACE_BEGIN
+
+template<class... Ts>
+class tuple;
+
+namespace detail {
+	// 空类且可以被继承时使用空基类优化
+	template<class T>
+	constexpr bool __use_ebo_v = std::is_empty_v<T> && !std::is_final_v<T>;
+
+	/**
+	 * tuple 的每一个元素保存在一个 leaf 中，Index 用于区分相同类型的元素
+	 * 空类型的元素作为基类，不占用空间
+	 */
+	template<size_t Index, class T, bool = __use_ebo_v<T>>
+	class __tuple_leaf
+	{
+	private:
+		T value;
+
+	public:
+		constexpr __tuple_leaf() : value() {}
+
+		template<class U>
+		constexpr explicit __tuple_leaf(std::in_place_t, U&& u) : value(std::forward<U>(u)) {}
+
+		constexpr T& get()noexcept { return value; }
+		constexpr const T& get()const noexcept { return value; }
+	};
+
+	template<size_t Index, class T>
+	class __tuple_leaf<Index, T, true> : private T
+	{
+	public:
+		constexpr __tuple_leaf() : T() {}
+
+		template<class U>
+		constexpr explicit __tuple_leaf(std::in_place_t, U&& u) : T(std::forward<U>(u)) {}
+
+		constexpr T& get()noexcept { return static_cast<T&>(*this); }
+		constexpr const T& get()const noexcept { return static_cast<const T&>(*this); }
+	};
+
+	template<class Indices, class... Ts>
+	class __tuple_impl;
+
+	template<size_t... I, class... Ts>
+	class __tuple_impl<std::index_sequence<I...>, Ts...> : public __tuple_leaf<I, Ts>...
+	{
+	public:
+		constexpr __tuple_impl() = default;
+
+		template<class... Us>
+		constexpr explicit __tuple_impl(std::in_place_t, Us&&... us)
+			: __tuple_leaf<I, Ts>(std::in_place, std::forward<Us>(us))... {}
+	};
+
+	// 第 I 个类型
+	template<size_t I, class... Ts>
+	using __nth_type_t = std::tuple_element_t<I, std::tuple<Ts...>>;
+}
+
+
+/**
+ * tuple
+ * 拷贝与移动全部为默认实现，元素均可平凡复制时 tuple 也可平凡复制
+ * 空类型的元素不占用空间
+ */
+template<class... Ts>
+class tuple : private detail::__tuple_impl<std::index_sequence_for<Ts...>, Ts...>
+{
+	template<size_t I, class... Us>
+	friend constexpr detail::__nth_type_t<I, Us...>& get(tuple<Us...>&)noexcept;
+
+	template<size_t I, class... Us>
+	friend constexpr const detail::__nth_type_t<I, Us...>& get(const tuple<Us...>&)noexcept;
+
+private:
+	using base = detail::__tuple_impl<std::index_sequence_for<Ts...>, Ts...>;
+
+public:
+	constexpr tuple() = default;
+
+	constexpr tuple(const Ts&... args) : base(std::in_place, args...) {}
+
+	template<class... Us, class = std::enable_if_t<sizeof...(Us) == sizeof...(Ts) && sizeof...(Ts) != 0 &&
+		(std::is_constructible_v<Ts, Us&&> && ...)>>
+	constexpr tuple(Us&&... args) : base(std::in_place, std::forward<Us>(args)...) {}
+
+	template<class... Us, class = std::enable_if_t<sizeof...(Us) == sizeof...(Ts) &&
+		(std::is_constructible_v<Ts, const Us&> && ...)>>
+	constexpr tuple(const tuple<Us...>& rhs) : tuple(rhs, std::index_sequence_for<Ts...>()) {}
+
+	template<class... Us, class = std::enable_if_t<sizeof...(Us) == sizeof...(Ts) &&
+		(std::is_constructible_v<Ts, Us&&> && ...)>>
+	constexpr tuple(tuple<Us...>&& rhs) : tuple(std::move(rhs), std::index_sequence_for<Ts...>()) {}
+
+	tuple(const tuple&) = default;
+	tuple(tuple&&) = default;
+	tuple& operator=(const tuple&) = default;
+	tuple& operator=(tuple&&) = default;
+
+	// 逐个元素赋值，使 tie(a, b) = make_tuple(x, y) 可用
+	template<class... Us, class = std::enable_if_t<sizeof...(Us) == sizeof...(Ts)>>
+	constexpr tuple& operator=(const tuple<Us...>& rhs)
+	{
+		__assign(rhs, std::index_sequence_for<Ts...>());
+		return *this;
+	}
+
+	template<class... Us, class = std::enable_if_t<sizeof...(Us) == sizeof...(Ts)>>
+	constexpr tuple& operator=(tuple<Us...>&& rhs)
+	{
+		__assign(std::move(rhs), std::index_sequence_for<Ts...>());
+		return *this;
+	}
+
+	constexpr void swap(tuple& rhs)
+	{
+		__swap(rhs, std::index_sequence_for<Ts...>());
+	}
+
+private:
+	template<class Tuple, size_t... I>
+	constexpr tuple(Tuple&& rhs, std::index_sequence<I...>)
+		: base(std::in_place, get<I>(std::forward<Tuple>(rhs))...) {}
+
+	template<class Tuple, size_t... I>
+	constexpr void __assign(Tuple&& rhs, std::index_sequence<I...>)
+	{
+		((get<I>(*this) = get<I>(std::forward<Tuple>(rhs))), ...);
+	}
+
+	template<size_t... I>
+	constexpr void __swap(tuple& rhs, std::index_sequence<I...>)
+	{
+		using std::swap;
+		(swap(get<I>(*this), get<I>(rhs)), ...);
+	}
+};
+
+template<>
+class tuple<>
+{
+public:
+	constexpr void swap(tuple&)noexcept {}
+};
+
+
+// get 函数
+template<size_t I, class... Ts>
+constexpr detail::__nth_type_t<I, Ts...>& get(tuple<Ts...>& t)noexcept
+{
+	using leaf = detail::__tuple_leaf<I, detail::__nth_type_t<I, Ts...>>;
+	return static_cast<leaf&>(t).get();
+}
+
+template<size_t I, class... Ts>
+constexpr const detail::__nth_type_t<I, Ts...>& get(const tuple<Ts...>& t)noexcept
+{
+	using leaf = detail::__tuple_leaf<I, detail::__nth_type_t<I, Ts...>>;
+	return static_cast<const leaf&>(t).get();
+}
+
+template<size_t I, class... Ts>
+constexpr detail::__nth_type_t<I, Ts...>&& get(tuple<Ts...>&& t)noexcept
+{
+	return std::forward<detail::__nth_type_t<I, Ts...>>(get<I>(t));
+}
+
+template<size_t I, class... Ts>
+constexpr const detail::__nth_type_t<I, Ts...>&& get(const tuple<Ts...>&& t)noexcept
+{
+	return std::forward<const detail::__nth_type_t<I, Ts...>>(get<I>(t));
+}
+
+
+namespace detail {
+	// 类型 T 在 Ts 中的下标，要求恰好出现一次
+	template<class T, class... Ts>
+	struct __type_index;
+
+	template<class T, class... Rest>
+	struct __type_index<T, T, Rest...> : sx_integral_constant<size_t, 0>
+	{
+		static_assert(!__is_type_in_pack_v<T, Rest...>, "type appears more than once in tuple");
+	};
+
+	template<class T, class First, class... Rest>
+	struct __type_index<T, First, Rest...> : sx_integral_constant<size_t, 1 + __type_index<T, Rest...>::value> {};
+
+	// make_tuple 对 reference_wrapper 解包为引用
+	template<class T>
+	struct __unwrap_reference : type_identity<T> {};
+
+	template<class T>
+	struct __unwrap_reference<std::reference_wrapper<T>> : type_identity<T&> {};
+
+	template<class T>
+	using __unwrap_decay_t = typename __unwrap_reference<std::decay_t<T>>::type;
+
+	template<class Function, class Tuple, size_t... I>
+	constexpr decltype(auto) __apply(Function&& f, Tuple&& t, std::index_sequence<I...>)
+	{
+		return std::invoke(std::forward<Function>(f), get<I>(std::forward<Tuple>(t))...);
+	}
+
+	template<class... Ts, class... Us, size_t... I>
+	constexpr bool __tuple_equal(const tuple<Ts...>& lhs, const tuple<Us...>& rhs, std::index_sequence<I...>)
+	{
+		return ((get<I>(lhs) == get<I>(rhs)) && ...);
+	}
+
+	template<size_t I, size_t N, class... Ts, class... Us>
+	constexpr bool __tuple_less(const tuple<Ts...>& lhs, const tuple<Us...>& rhs)
+	{
+		if constexpr (I == N)
+			return false;
+		else
+		{
+			if (get<I>(lhs) < get<I>(rhs)) return true;
+			if (get<I>(rhs) < get<I>(lhs)) return false;
+			return __tuple_less<I + 1, N>(lhs, rhs);
+		}
+	}
+}
+
+template<class T, class... Ts>
+constexpr T& get(tuple<Ts...>& t)noexcept
+{
+	return get<detail::__type_index<T, Ts...>::value>(t);
+}
+
+template<class T, class... Ts>
+constexpr const T& get(const tuple<Ts...>& t)noexcept
+{
+	return get<detail::__type_index<T, Ts...>::value>(t);
+}
+
+
+// 辅助函数
+template<class... Ts>
+constexpr tuple<detail::__unwrap_decay_t<Ts>...> make_tuple(Ts&&... args)
+{
+	return tuple<detail::__unwrap_decay_t<Ts>...>(std::forward<Ts>(args)...);
+}
+
+template<class... Ts>
+constexpr tuple<Ts&&...> forward_as_tuple(Ts&&... args)noexcept
+{
+	return tuple<Ts&&...>(std::forward<Ts>(args)...);
+}
+
+template<class... Ts>
+constexpr tuple<Ts&...> tie(Ts&... args)noexcept
+{
+	return tuple<Ts&...>(args...);
+}
+
+// 以 tuple 的各元素为参数调用 f
+template<class Function, class Tuple>
+constexpr decltype(auto) apply(Function&& f, Tuple&& t)
+{
+	return detail::__apply(std::forward<Function>(f), std::forward<Tuple>(t),
+		std::make_index_sequence<std::tuple_size_v<std::remove_reference_t<Tuple>>>());
+}
+
+
+// 比较操作
+template<class... Ts, class... Us>
+constexpr bool operator==(const tuple<Ts...>& lhs, const tuple<Us...>& rhs)
+{
+	static_assert(sizeof...(Ts) == sizeof...(Us), "can not compare tuples of different sizes");
+	return detail::__tuple_equal(lhs, rhs, std::index_sequence_for<Ts...>());
+}
+
+template<class... Ts, class... Us>
+constexpr bool operator!=(const tuple<Ts...>& lhs, const tuple<Us...>& rhs)
+{
+	return !(lhs == rhs);
+}
+
+template<class... Ts, class... Us>
+constexpr bool operator<(const tuple<Ts...>& lhs, const tuple<Us...>& rhs)
+{
+	static_assert(sizeof...(Ts) == sizeof...(Us), "can not compare tuples of different sizes");
+	return detail::__tuple_less<0, sizeof...(Ts)>(lhs, rhs);
+}
+
+template<class... Ts, class... Us>
+constexpr bool operator>(const tuple<Ts...>& lhs, const tuple<Us...>& rhs)
+{
+	return rhs < lhs;
+}
+
+template<class... Ts, class... Us>
+constexpr bool operator<=(const tuple<Ts...>& lhs, const tuple<Us...>& rhs)
+{
+	return !(rhs < lhs);
+}
+
+template<class... Ts, class... Us>
+constexpr bool operator>=(const tuple<Ts...>& lhs, const tuple<Us...>& rhs)
+{
+	return !(lhs < rhs);
+}
+
+template<class... Ts>
+constexpr void swap(tuple<Ts...>& lhs, tuple<Ts...>& rhs)
+{
+	lhs.swap(rhs);
+}
+
+SX_NAMESPACE_END
+
+
+// 使 sx::tuple 支持结构化绑定以及 std::tuple_size / std::tuple_element
+template<class... Ts>
+struct std::tuple_size<sx::tuple<Ts...>> : std::integral_constant<size_t, sizeof...(Ts)> {};
+
+template<size_t I, class... Ts>
+struct std::tuple_element<I, sx::tuple<Ts...>>
+{
+	using type = sx::detail::__nth_type_t<I, Ts...>;
+};
+
+#endif	// end define _SX_TUPLE_H_
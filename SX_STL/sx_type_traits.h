@@ -7,6 +7,8 @@
 
 #ifndef _SX_TYPE_TRAITS_H_
 #define _SX_TYPE_TRAITS_H_
+#include <string_view>		// std::string_view
+#include <utility>			// std::pair
 #include "sx_def.h"
 
 SX_NAMESPACE_BEGIN
@@ -331,17 +333,9 @@ struct is_same<T, T> : sx_true_type {};
 template<class T1, class T2>
 constexpr bool is_same_v = is_same<T1, T2>::value;
 
-// pair 的一个简单定义
+// pair 定义于 sx_utility.h
 template<class T1, class T2>
-struct pair
-{
-	using type = pair;
-	T1 first;
-	T2 second;
-	
-	pair(const T1& t1 = T1(), const T2& t2 = T2())
-		:first(t1), second(t2) {}
-};
+struct pair;
 
 // is_pair and is_pair_v
 template<class>
@@ -371,6 +365,7 @@ constexpr bool is_pair_v = is_pair<T>::value;
  * is_enum						+
  * is_union						+
  * is_class						+
+ * is_trivially_copyable		+
  * is_function					*
  * is_pointer					*
  * is_lvalue_reference			*
@@ -428,7 +423,7 @@ template<bool... args>
 struct __is_false_in_pack<true, args...> : __is_false_in_pack<args...> {};
 
 template<bool... args>
-constexpr bool __is_false_in_pack_v = __is_false_in_pack<args...>;
+constexpr bool __is_false_in_pack_v = __is_false_in_pack<args...>::value;
 
 // 检查不定长类型参数列表中是否包含类型 T, 若存在类型 T 即返回 true
 // __is_type_in_pack __is_type_in_pack_v
@@ -528,6 +523,14 @@ template<class T>
 constexpr bool is_class_v = is_class<T>::value;
 
 
+// is_trivially_copyable and is_trivially_copyable_v
+template<class T>
+struct is_trivially_copyable : sx_bool_constant_t<__is_trivially_copyable(T)> {};	// __is_trivially_copyable() 由编译器支持
+
+template<class T>
+constexpr bool is_trivially_copyable_v = is_trivially_copyable<T>::value;
+
+
 #ifndef __IS_FUNCTION_ACHIEVE
 #define	__IS_FUNCTION_ACHIEVE 1
 
@@ -683,6 +686,16 @@ template<class T>
 constexpr bool is_member_function_pointer_v = is_member_function_pointer<T>::value;
 
 
+// is_frozen_key and is_frozen_key_v
+// 可以在编译期求哈希的键：除 bool 以外的整数，以及以 std::string_view 保存的字符串字面量
+template<class T>
+struct is_frozen_key : sx_bool_constant_t<(is_integral_v<T> && !is_same_v<remove_cv_t<T>, bool>) ||
+	is_same_v<remove_cv_t<T>, std::string_view>> {};
+
+template<class T>
+constexpr bool is_frozen_key_v = is_frozen_key<T>::value;
+
+
 
 SX_NAMESPACE_END
 #endif	// end _SX_TYPE_TRAITS_H_
\ No newline at end of file
@@ -0,0 +1,279 @@
+﻿/**************************************************
+ * @brief   : pair, compressed_pair 等工具
+ * @file    : sx_utility.h
+ * @author  : 宋旭
+ * @date    : 2026年10月18日，20:58:03
+ **************************************************/
+
+#ifndef _SX_UTILITY_H_
+#define _SX_UTILITY_H_
+#include <tuple>			// tuple_size, tuple_element
+#include <type_traits>		// is_constructible, is_convertible
+#include <utility>			// move, forward, index_sequence
+#include "sx_type_traits.h"
+#include "sx_tuple.h"
+
+SX_NAMESPACE_BEGIN
+
+// 分段构造的标记，pair(piecewise_construct, tuple(...), tuple(...))
+struct piecewise_construct_t
+{
+	explicit piecewise_construct_t() = default;
+};
+
+inline constexpr piecewise_construct_t piecewise_construct{};
+
+
+/**
+ * pair
+ * 拷贝与移动全部为默认实现，两个成员均可平凡复制时 pair 也可平凡复制
+ * 通过完美转发构造成员，避免插入时多余的复制
+ */
+template<class T1, class T2>
+struct pair
+{
+	using type			= pair;
+	using first_type	= T1;
+	using second_type	= T2;
+
+	T1 first;
+	T2 second;
+
+	constexpr pair() : first(), second() {}
+
+	constexpr pair(const T1& t1, const T2& t2) : first(t1), second(t2) {}
+
+	template<class U1, class U2, class = std::enable_if_t<
+		std::is_constructible_v<T1, U1&&> && std::is_constructible_v<T2, U2&&>>>
+	constexpr pair(U1&& u1, U2&& u2) : first(std::forward<U1>(u1)), second(std::forward<U2>(u2)) {}
+
+	template<class U1, class U2, class = std::enable_if_t<
+		std::is_constructible_v<T1, const U1&> && std::is_constructible_v<T2, const U2&>>>
+	constexpr pair(const pair<U1, U2>& rhs) : first(rhs.first), second(rhs.second) {}
+
+	template<class U1, class U2, class = std::enable_if_t<
+		std::is_constructible_v<T1, U1&&> && std::is_constructible_v<T2, U2&&>>>
+	constexpr pair(pair<U1, U2>&& rhs) : first(std::forward<U1>(rhs.first)), second(std::forward<U2>(rhs.second)) {}
+
+	// 从 std::pair 转换
+	template<class U1, class U2, class = std::enable_if_t<
+		std::is_constructible_v<T1, const U1&> && std::is_constructible_v<T2, const U2&>>>
+	constexpr pair(const std::pair<U1, U2>& rhs) : first(rhs.first), second(rhs.second) {}
+
+	// 分段构造，两个 tuple 分别作为 first 和 second 构造函数的参数
+	template<class... Args1, class... Args2>
+	constexpr pair(piecewise_construct_t, tuple<Args1...> args1, tuple<Args2...> args2)
+		: pair(args1, args2, std::index_sequence_for<Args1...>(), std::index_sequence_for<Args2...>()) {}
+
+	pair(const pair&) = default;
+	pair(pair&&) = default;
+	pair& operator=(const pair&) = default;
+	pair& operator=(pair&&) = default;
+
+	template<class U1, class U2>
+	constexpr pair& operator=(const pair<U1, U2>& rhs)
+	{
+		first = rhs.first;
+		second = rhs.second;
+		return *this;
+	}
+
+	template<class U1, class U2>
+	constexpr pair& operator=(pair<U1, U2>&& rhs)
+	{
+		first = std::forward<U1>(rhs.first);
+		second = std::forward<U2>(rhs.second);
+		return *this;
+	}
+
+	constexpr void swap(pair& rhs)
+	{
+		using std::swap;
+		swap(first, rhs.first);
+		swap(second, rhs.second);
+	}
+
+private:
+	template<class Tuple1, class Tuple2, size_t... I1, size_t... I2>
+	constexpr pair(Tuple1& args1, Tuple2& args2, std::index_sequence<I1...>, std::index_sequence<I2...>)
+		: first(get<I1>(std::move(args1))...), second(get<I2>(std::move(args2))...) {}
+};
+
+template<class T1, class T2>
+pair(T1, T2) -> pair<T1, T2>;
+
+
+// make_pair
+template<class T1, class T2>
+constexpr pair<detail::__unwrap_decay_t<T1>, detail::__unwrap_decay_t<T2>> make_pair(T1&& t1, T2&& t2)
+{
+	return pair<detail::__unwrap_decay_t<T1>, detail::__unwrap_decay_t<T2>>(std::forward<T1>(t1), std::forward<T2>(t2));
+}
+
+
+// 比较操作
+template<class T1, class T2>
+constexpr bool operator==(const pair<T1, T2>& lhs, const pair<T1, T2>& rhs)
+{
+	return lhs.first == rhs.first && lhs.second == rhs.second;
+}
+
+template<class T1, class T2>
+constexpr bool operator!=(const pair<T1, T2>& lhs, const pair<T1, T2>& rhs)
+{
+	return !(lhs == rhs);
+}
+
+template<class T1, class T2>
+constexpr bool operator<(const pair<T1, T2>& lhs, const pair<T1, T2>& rhs)
+{
+	return lhs.first < rhs.first || (!(rhs.first < lhs.first) && lhs.second < rhs.second);
+}
+
+template<class T1, class T2>
+constexpr bool operator>(const pair<T1, T2>& lhs, const pair<T1, T2>& rhs)
+{
+	return rhs < lhs;
+}
+
+template<class T1, class T2>
+constexpr bool operator<=(const pair<T1, T2>& lhs, const pair<T1, T2>& rhs)
+{
+	return !(rhs < lhs);
+}
+
+template<class T1, class T2>
+constexpr bool operator>=(const pair<T1, T2>& lhs, const pair<T1, T2>& rhs)
+{
+	return !(lhs < rhs);
+}
+
+template<class T1, class T2>
+constexpr void swap(pair<T1, T2>& lhs, pair<T1, T2>& rhs)
+{
+	lhs.swap(rhs);
+}
+
+
+// get 函数
+template<size_t I, class T1, class T2>
+constexpr auto& get(pair<T1, T2>& p)noexcept
+{
+	static_assert(I < 2, "pair index out of range");
+	if constexpr (I == 0) return p.first;
+	else return p.second;
+}
+
+template<size_t I, class T1, class T2>
+constexpr const auto& get(const pair<T1, T2>& p)noexcept
+{
+	static_assert(I < 2, "pair index out of range");
+	if constexpr (I == 0) return p.first;
+	else return p.second;
+}
+
+template<size_t I, class T1, class T2>
+constexpr auto&& get(pair<T1, T2>&& p)noexcept
+{
+	static_assert(I < 2, "pair index out of range");
+	if constexpr (I == 0) return std::forward<T1>(p.first);
+	else return std::forward<T2>(p.second);
+}
+
+
+/**
+ * compressed_pair
+ * 利用空基类优化保存两个对象，空类型(无状态的比较器，分配器，哈希函数等)不占用空间
+ * 容器用它保存 "比较器 + 数据"，使无状态比较器的容器不因此多占一个指针大小
+ */
+namespace detail {
+	template<class T, size_t Index, bool = __use_ebo_v<T>>
+	class __compressed_element
+	{
+	private:
+		T value;
+
+	public:
+		constexpr __compressed_element() : value() {}
+
+		template<class... Args>
+		constexpr explicit __compressed_element(std::in_place_t, Args&&... args) : value(std::forward<Args>(args)...) {}
+
+		constexpr T& get()noexcept { return value; }
+		constexpr const T& get()const noexcept { return value; }
+	};
+
+	template<class T, size_t Index>
+	class __compressed_element<T, Index, true> : private T
+	{
+	public:
+		constexpr __compressed_element() : T() {}
+
+		template<class... Args>
+		constexpr explicit __compressed_element(std::in_place_t, Args&&... args) : T(std::forward<Args>(args)...) {}
+
+		constexpr T& get()noexcept { return static_cast<T&>(*this); }
+		constexpr const T& get()const noexcept { return static_cast<const T&>(*this); }
+	};
+}
+
+template<class T1, class T2>
+class compressed_pair : private detail::__compressed_element<T1, 0>, private detail::__compressed_element<T2, 1>
+{
+private:
+	using first_base	= detail::__compressed_element<T1, 0>;
+	using second_base	= detail::__compressed_element<T2, 1>;
+
+public:
+	using first_type	= T1;
+	using second_type	= T2;
+
+	constexpr compressed_pair() = default;
+
+	template<class U1, class U2>
+	constexpr compressed_pair(U1&& u1, U2&& u2)
+		: first_base(std::in_place, std::forward<U1>(u1)), second_base(std::in_place, std::forward<U2>(u2)) {}
+
+	// 分段构造
+	template<class... Args1, class... Args2>
+	constexpr compressed_pair(piecewise_construct_t, tuple<Args1...> args1, tuple<Args2...> args2)
+		: compressed_pair(args1, args2, std::index_sequence_for<Args1...>(), std::index_sequence_for<Args2...>()) {}
+
+	constexpr T1& first()noexcept { return first_base::get(); }
+	constexpr const T1& first()const noexcept { return first_base::get(); }
+	constexpr T2& second()noexcept { return second_base::get(); }
+	constexpr const T2& second()const noexcept { return second_base::get(); }
+
+	constexpr void swap(compressed_pair& rhs)
+	{
+		using std::swap;
+		swap(first(), rhs.first());
+		swap(second(), rhs.second());
+	}
+
+private:
+	template<class Tuple1, class Tuple2, size_t... I1, size_t... I2>
+	constexpr compressed_pair(Tuple1& args1, Tuple2& args2, std::index_sequence<I1...>, std::index_sequence<I2...>)
+		: first_base(std::in_place, get<I1>(std::move(args1))...), second_base(std::in_place, get<I2>(std::move(args2))...) {}
+};
+
+SX_NAMESPACE_END
+
+
+// 使 sx::pair 支持结构化绑定
+template<class T1, class T2>
+struct std::tuple_size<sx::pair<T1, T2>> : std::integral_constant<size_t, 2> {};
+
+template<class T1, class T2>
+struct std::tuple_element<0, sx::pair<T1, T2>>
+{
+	using type = T1;
+};
+
+template<class T1, class T2>
+struct std::tuple_element<1, sx::pair<T1, T2>>
+{
+	using type = T2;
+};
+
+#endif	// end define _SX_UTILITY_H_
@@ -0,0 +1,744 @@
+﻿/**************************************************
+ * @brief   : 惰性求值的区间视图
+ * @file    : sx_views.h
+ * @author  : 宋旭
+ * @date    : 2026年10月18日，19:52:16
+ **************************************************/
+
+#ifndef _SX_VIEWS_H_
+#define _SX_VIEWS_H_
+#include <cstdint>			// PTRDIFF_MAX
+#include <functional>		// invoke
+#include <stdexcept>		// invalid_argument
+#include <tuple>			// tuple, apply
+#include <type_traits>		// conditional_t, remove_cvref_t
+#include <utility>			// move, forward, declval, index_sequence
+#include "sx_iterator.h"
+#include "sx_utility.h"
+
+SX_NAMESPACE_BEGIN
+
+/**
+ * 视图不持有元素，只在迭代时按需计算，多个视图通过 operator| 组合后仍然只遍历一次：
+ *
+ * for (auto x : v | views::filter(pred) | views::transform(f) | views::take(10))
+ *
+ * filter		-- 只保留满足谓词的元素，迭代器至多为双向迭代器
+ * transform	-- 对每个元素调用函数
+ * take			-- 前 n 个元素，非随机访问时至多为前向迭代器
+ * drop			-- 跳过前 n 个元素
+ * chunk		-- 每 n 个元素组成一个 subrange，前向迭代器，n 必须为正
+ * zip			-- 多个区间对应位置的元素组成 tuple，长度取最短的区间，非随机访问时至多为前向迭代器
+ * enumerate	-- tuple(下标, 元素)，非随机访问时至多为前向迭代器
+ *
+ * 迭代器的类型由底层区间通过 iterator_traits 决定，并按视图的性质降级
+ * 左值区间按引用保存，右值区间被移动到视图中
+ */
+
+namespace detail {
+	template<class Range>
+	using __range_iterator_t = decltype(std::declval<const Range&>().begin());
+
+	template<class Iterator>
+	using __iter_category_t = typename iterator_traits<Iterator>::iterator_category;
+
+	template<class Iterator>
+	using __iter_value_t = typename iterator_traits<Iterator>::value_type;
+
+	template<class Iterator>
+	using __iter_difference_t = typename iterator_traits<Iterator>::difference_type;
+
+	template<class Iterator>
+	using __iter_reference_t = decltype(*std::declval<const Iterator&>());
+
+	// 两种迭代器类型中较弱的一种
+	template<class A, class B>
+	using __min_category_t = std::conditional_t<std::is_convertible_v<A, B>, B, A>;
+
+	template<class Category, class... Rest>
+	struct __min_category : type_identity<Category> {};
+
+	template<class A, class B, class... Rest>
+	struct __min_category<A, B, Rest...> : __min_category<__min_category_t<A, B>, Rest...> {};
+
+	template<class Iterator, class Category>
+	constexpr bool __has_category_v = std::is_convertible_v<__iter_category_t<Iterator>, Category>;
+
+	// 对左值区间的引用
+	template<class Range>
+	class __ref_view
+	{
+	private:
+		Range* range;
+
+	public:
+		explicit __ref_view(Range& r)noexcept : range(&r) {}
+
+		auto begin()const { return range->begin(); }
+		auto end()const { return range->end(); }
+	};
+
+	template<class Range>
+	using __all_t = std::conditional_t<std::is_lvalue_reference_v<Range>,
+		__ref_view<std::remove_reference_t<Range>>, std::remove_cvref_t<Range>>;
+
+	template<class Range>
+	inline __all_t<Range> __all(Range&& r)
+	{
+		if constexpr (std::is_lvalue_reference_v<Range>)
+			return __all_t<Range>(r);
+		else
+			return std::move(r);
+	}
+
+	// 可以放在 operator| 右侧的适配器
+	template<class Function>
+	struct __range_adaptor_closure
+	{
+		Function function;
+
+		template<class Range>
+		auto operator()(Range&& r)const
+		{
+			return function(std::forward<Range>(r));
+		}
+	};
+
+	// 与适配器位于同一命名空间，通过 ADL 查找，使用时无需 using namespace sx
+	template<class Range, class Function>
+	inline auto operator|(Range&& r, const __range_adaptor_closure<Function>& closure)
+	{
+		return closure(std::forward<Range>(r));
+	}
+
+	template<class Function>
+	inline __range_adaptor_closure<Function> __make_closure(Function f)
+	{
+		return __range_adaptor_closure<Function>{ std::move(f) };
+	}
+
+	// [first, last) 中不超过 n 步的位置，n 不能为负
+	template<class Iterator, class Distance>
+	inline Iterator __bounded_next(Iterator first, Iterator last, Distance n)
+	{
+		if constexpr (__has_category_v<Iterator, random_access_iterator_tag>)
+		{
+			Distance len = static_cast<Distance>(last - first);
+			return first + (n < len ? n : len);
+		}
+		else
+		{
+			for (; n > 0 && first != last; --n) ++first;
+			return first;
+		}
+	}
+}
+
+
+// 由一对迭代器表示的区间
+template<class Iterator>
+class subrange
+{
+private:
+	Iterator first;
+	Iterator last;
+
+public:
+	subrange() = default;
+	subrange(Iterator b, Iterator e) : first(b), last(e) {}
+
+	Iterator begin()const { return first; }
+	Iterator end()const { return last; }
+
+	SX_NODISCARD bool empty()const { return first == last; }
+	size_t size()const { return static_cast<size_t>(sx::distance(first, last)); }
+};
+
+
+/**
+ * filter_view
+ */
+template<class View, class Pred>
+class filter_view
+{
+private:
+	using base_iterator = detail::__range_iterator_t<View>;
+
+	compressed_pair<View, Pred> data;	// 无捕获的谓词不占用空间
+
+	const View& __base()const noexcept { return data.first(); }
+	const Pred& __pred()const noexcept { return data.second(); }
+
+public:
+	class iterator : public sx::iterator<
+		detail::__min_category_t<detail::__iter_category_t<base_iterator>, bidirectional_iterator_tag>,
+		detail::__iter_value_t<base_iterator>, detail::__iter_difference_t<base_iterator>,
+		void, detail::__iter_reference_t<base_iterator>>
+	{
+	private:
+		base_iterator		cur{};
+		base_iterator		last{};
+		const filter_view*	parent = nullptr;
+
+	public:
+		using self = iterator;
+
+		iterator() = default;
+		iterator(const filter_view* p, base_iterator c, base_iterator l) : cur(c), last(l), parent(p)
+		{
+			__satisfy();
+		}
+
+		base_iterator base()const { return cur; }
+
+		decltype(auto) operator*()const { return *cur; }
+
+		self& operator++()
+		{
+			++cur;
+			__satisfy();
+			return *this;
+		}
+
+		self operator++(int)
+		{
+			auto temp = *this;
+			++*this;
+			return temp;
+		}
+
+		self& operator--()
+		{
+			do --cur; while (!std::invoke(parent->__pred(), *cur));
+			return *this;
+		}
+
+		self operator--(int)
+		{
+			auto temp = *this;
+			--*this;
+			return temp;
+		}
+
+		bool operator==(const self& rhs)const { return cur == rhs.cur; }
+		bool operator!=(const self& rhs)const { return cur != rhs.cur; }
+
+	private:
+		void __satisfy()
+		{
+			while (cur != last && !std::invoke(parent->__pred(), *cur)) ++cur;
+		}
+	};
+
+public:
+	filter_view(View v, Pred p) : data(std::move(v), std::move(p)) {}
+
+	iterator begin()const { return iterator(this, __base().begin(), __base().end()); }
+	iterator end()const { return iterator(this, __base().end(), __base().end()); }
+};
+
+
+/**
+ * transform_view
+ */
+template<class View, class Function>
+class transform_view
+{
+private:
+	using base_iterator = detail::__range_iterator_t<View>;
+	using result_type = decltype(std::invoke(std::declval<const Function&>(), *std::declval<base_iterator>()));
+
+	compressed_pair<View, Function> data;	// 无捕获的函数对象不占用空间
+
+	const View& __base()const noexcept { return data.first(); }
+	const Function& __function()const noexcept { return data.second(); }
+
+public:
+	class iterator : public sx::iterator<detail::__iter_category_t<base_iterator>, std::remove_cvref_t<result_type>,
+		detail::__iter_difference_t<base_iterator>, void, result_type>
+	{
+	private:
+		base_iterator			cur{};
+		const transform_view*	parent = nullptr;
+
+	public:
+		using self				= iterator;
+		using difference_type	= detail::__iter_difference_t<base_iterator>;
+
+		iterator() = default;
+		iterator(const transform_view* p, base_iterator c) : cur(c), parent(p) {}
+
+		base_iterator base()const { return cur; }
+
+		result_type operator*()const { return std::invoke(parent->__function(), *cur); }
+		result_type operator[](difference_type n)const { return std::invoke(parent->__function(), cur[n]); }
+
+		self& operator++() { ++cur; return *this; }
+		self operator++(int) { auto temp = *this; ++cur; return temp; }
+		self& operator--() { --cur; return *this; }
+		self operator--(int) { auto temp = *this; --cur; return temp; }
+		self& operator+=(difference_type n) { cur += n; return *this; }
+		self& operator-=(difference_type n) { cur -= n; return *this; }
+		self operator+(difference_type n)const { return self(parent, cur + n); }
+		self operator-(difference_type n)const { return self(parent, cur - n); }
+		difference_type operator-(const self& rhs)const { return cur - rhs.cur; }
+
+		bool operator==(const self& rhs)const { return cur == rhs.cur; }
+		bool operator!=(const self& rhs)const { return cur != rhs.cur; }
+		bool operator<(const self& rhs)const { return cur < rhs.cur; }
+		bool operator<=(const self& rhs)const { return cur <= rhs.cur; }
+		bool operator>(const self& rhs)const { return cur > rhs.cur; }
+		bool operator>=(const self& rhs)const { return cur >= rhs.cur; }
+	};
+
+public:
+	transform_view(View v, Function f) : data(std::move(v), std::move(f)) {}
+
+	iterator begin()const { return iterator(this, __base().begin()); }
+	iterator end()const { return iterator(this, __base().end()); }
+};
+
+
+/**
+ * take_view
+ * 底层为随机访问迭代器时直接返回底层迭代器，否则使用计数迭代器
+ */
+namespace detail {
+	template<class Iterator>
+	class __counted_iterator : public sx::iterator<__min_category_t<__iter_category_t<Iterator>, forward_iterator_tag>,
+		__iter_value_t<Iterator>, __iter_difference_t<Iterator>, void, __iter_reference_t<Iterator>>
+	{
+	private:
+		Iterator					cur{};
+		Iterator					last{};
+		__iter_difference_t<Iterator>	remaining = 0;
+
+	public:
+		using self = __counted_iterator;
+
+		__counted_iterator() = default;
+		__counted_iterator(Iterator c, Iterator l, __iter_difference_t<Iterator> n) : cur(c), last(l), remaining(n) {}
+
+		decltype(auto) operator*()const { return *cur; }
+
+		self& operator++()
+		{
+			++cur;
+			--remaining;
+			return *this;
+		}
+
+		self operator++(int)
+		{
+			auto temp = *this;
+			++*this;
+			return temp;
+		}
+
+		// 计数用尽或到达底层末尾的迭代器都视为末尾
+		bool operator==(const self& rhs)const
+		{
+			bool done = __done(), rhs_done = rhs.__done();
+			return done == rhs_done && (done || cur == rhs.cur);
+		}
+
+		bool operator!=(const self& rhs)const { return !(*this == rhs); }
+
+	private:
+		bool __done()const { return remaining <= 0 || cur == last; }
+	};
+}
+
+template<class View>
+class take_view
+{
+private:
+	using base_iterator		= detail::__range_iterator_t<View>;
+	using difference_type	= detail::__iter_difference_t<base_iterator>;
+
+	static constexpr bool random_access = detail::__has_category_v<base_iterator, random_access_iterator_tag>;
+
+	View			base;
+	difference_type	count;
+
+public:
+	using iterator = std::conditional_t<random_access, base_iterator, detail::__counted_iterator<base_iterator>>;
+
+	take_view(View v, difference_type n) : base(std::move(v)), count(n)
+	{
+		if (n < 0) throw std::invalid_argument("views::take: count must not be negative");
+	}
+
+	iterator begin()const
+	{
+		if constexpr (random_access) return base.begin();
+		else return iterator(base.begin(), base.end(), count);
+	}
+
+	iterator end()const
+	{
+		if constexpr (random_access) return detail::__bounded_next(base.begin(), base.end(), count);
+		else return iterator(base.end(), base.end(), 0);
+	}
+};
+
+
+/**
+ * drop_view
+ */
+template<class View>
+class drop_view
+{
+private:
+	using base_iterator		= detail::__range_iterator_t<View>;
+	using difference_type	= detail::__iter_difference_t<base_iterator>;
+
+	View			base;
+	difference_type	count;
+
+public:
+	using iterator = base_iterator;
+
+	drop_view(View v, difference_type n) : base(std::move(v)), count(n)
+	{
+		if (n < 0) throw std::invalid_argument("views::drop: count must not be negative");
+	}
+
+	iterator begin()const { return detail::__bounded_next(base.begin(), base.end(), count); }
+	iterator end()const { return base.end(); }
+};
+
+
+/**
+ * chunk_view
+ * 每次解引用得到一个至多 n 个元素的 subrange，最后一块可能不足 n 个
+ */
+template<class View>
+class chunk_view
+{
+private:
+	using base_iterator		= detail::__range_iterator_t<View>;
+	using difference_type	= detail::__iter_difference_t<base_iterator>;
+
+	View			base;
+	difference_type	count;
+
+public:
+	class iterator : public sx::iterator<forward_iterator_tag, subrange<base_iterator>, difference_type, void, subrange<base_iterator>>
+	{
+	private:
+		base_iterator	cur{};
+		base_iterator	next{};
+		base_iterator	last{};
+		difference_type	n = 0;
+
+	public:
+		using self = iterator;
+
+		iterator() = default;
+		iterator(base_iterator c, base_iterator l, difference_type size)
+			: cur(c), next(detail::__bounded_next(c, l, size)), last(l), n(size) {}
+
+		subrange<base_iterator> operator*()const { return subrange<base_iterator>(cur, next); }
+
+		self& operator++()
+		{
+			cur = next;
+			next = detail::__bounded_next(cur, last, n);
+			return *this;
+		}
+
+		self operator++(int)
+		{
+			auto temp = *this;
+			++*this;
+			return temp;
+		}
+
+		bool operator==(const self& rhs)const { return cur == rhs.cur; }
+		bool operator!=(const self& rhs)const { return cur != rhs.cur; }
+	};
+
+public:
+	chunk_view(View v, difference_type n) : base(std::move(v)), count(n)
+	{
+		if (n <= 0) throw std::invalid_argument("views::chunk: chunk size must be positive");
+	}
+
+	iterator begin()const { return iterator(base.begin(), base.end(), count); }
+	iterator end()const { return iterator(base.end(), base.end(), count); }
+};
+
+
+/**
+ * zip_view
+ * 任一分量到达末尾即视为末尾
+ */
+template<class... Views>
+class zip_view
+{
+private:
+	// 各分量都是随机访问时，end 可以由 begin 加上最短长度得到，各分量对齐，可以反向移动
+	// 否则 end 只是各分量的 end，只能用来比较，迭代器降为前向迭代器
+	static constexpr bool random_access =
+		(detail::__has_category_v<detail::__range_iterator_t<Views>, random_access_iterator_tag> && ...);
+
+	using category = std::conditional_t<random_access,
+		typename detail::__min_category<detail::__iter_category_t<detail::__range_iterator_t<Views>>...>::type,
+		detail::__min_category_t<typename detail::__min_category<
+			detail::__iter_category_t<detail::__range_iterator_t<Views>>...>::type, forward_iterator_tag>>;
+
+	std::tuple<Views...> bases;
+
+public:
+	class iterator : public sx::iterator<category,
+		std::tuple<detail::__iter_value_t<detail::__range_iterator_t<Views>>...>, ptrdiff_t, void,
+		std::tuple<detail::__iter_reference_t<detail::__range_iterator_t<Views>>...>>
+	{
+	private:
+		using iterators_type = std::tuple<detail::__range_iterator_t<Views>...>;
+		using indices = std::index_sequence_for<Views...>;
+
+		iterators_type iters;
+
+	public:
+		using self				= iterator;
+		using reference			= std::tuple<detail::__iter_reference_t<detail::__range_iterator_t<Views>>...>;
+		using difference_type	= ptrdiff_t;
+
+		iterator() = default;
+		explicit iterator(iterators_type its) : iters(std::move(its)) {}
+
+		reference operator*()const
+		{
+			return std::apply([](const auto&... it) { return reference(*it...); }, iters);
+		}
+
+		reference operator[](difference_type n)const { return *(*this + n); }
+
+		self& operator++() { std::apply([](auto&... it) { (++it, ...); }, iters); return *this; }
+		self operator++(int) { auto temp = *this; ++*this; return temp; }
+		self& operator--() { std::apply([](auto&... it) { (--it, ...); }, iters); return *this; }
+		self operator--(int) { auto temp = *this; --*this; return temp; }
+		self& operator+=(difference_type n) { std::apply([n](auto&... it) { ((it += n), ...); }, iters); return *this; }
+		self& operator-=(difference_type n) { return *this += -n; }
+		self operator+(difference_type n)const { auto temp = *this; return temp += n; }
+		self operator-(difference_type n)const { auto temp = *this; return temp += -n; }
+
+		// 各分量距离中绝对值最小的一个，与 "最短区间" 的语义一致
+		difference_type operator-(const self& rhs)const
+		{
+			return __distance_to(rhs, indices());
+		}
+
+		bool operator==(const self& rhs)const { return __any_equal(rhs, indices()); }
+		bool operator!=(const self& rhs)const { return !(*this == rhs); }
+		bool operator<(const self& rhs)const { return (*this - rhs) < 0; }
+		bool operator<=(const self& rhs)const { return (*this - rhs) <= 0; }
+		bool operator>(const self& rhs)const { return (*this - rhs) > 0; }
+		bool operator>=(const self& rhs)const { return (*this - rhs) >= 0; }
+
+	private:
+		template<size_t... I>
+		bool __any_equal(const self& rhs, std::index_sequence<I...>)const
+		{
+			return ((std::get<I>(iters) == std::get<I>(rhs.iters)) || ...);
+		}
+
+		template<size_t... I>
+		difference_type __distance_to(const self& rhs, std::index_sequence<I...>)const
+		{
+			difference_type result = static_cast<difference_type>(std::get<0>(iters) - std::get<0>(rhs.iters));
+			((result = __closer(result, static_cast<difference_type>(std::get<I>(iters) - std::get<I>(rhs.iters)))), ...);
+			return result;
+		}
+
+		static difference_type __closer(difference_type a, difference_type b)
+		{
+			return (a < 0 ? -a : a) <= (b < 0 ? -b : b) ? a : b;
+		}
+	};
+
+public:
+	explicit zip_view(Views... vs) : bases(std::move(vs)...) {}
+
+	iterator begin()const
+	{
+		return iterator(std::apply([](const auto&... v) { return std::make_tuple(v.begin()...); }, bases));
+	}
+
+	iterator end()const
+	{
+		if constexpr (random_access)
+		{
+			ptrdiff_t len = std::apply([](const auto&... v) {
+				ptrdiff_t n = PTRDIFF_MAX;
+				((n = (v.end() - v.begin() < n ? static_cast<ptrdiff_t>(v.end() - v.begin()) : n)), ...);
+				return n;
+			}, bases);
+			return begin() + len;
+		}
+		else
+		{
+			return iterator(std::apply([](const auto&... v) { return std::make_tuple(v.end()...); }, bases));
+		}
+	}
+};
+
+
+/**
+ * enumerate_view
+ */
+template<class View>
+class enumerate_view
+{
+private:
+	using base_iterator = detail::__range_iterator_t<View>;
+
+	// 随机访问时 end 的下标为区间长度，可以反向移动；否则 end 的下标未知，降为前向迭代器
+	static constexpr bool random_access = detail::__has_category_v<base_iterator, random_access_iterator_tag>;
+
+	using category = std::conditional_t<random_access, detail::__iter_category_t<base_iterator>,
+		detail::__min_category_t<detail::__iter_category_t<base_iterator>, forward_iterator_tag>>;
+
+	View base;
+
+public:
+	class iterator : public sx::iterator<category,
+		std::tuple<detail::__iter_difference_t<base_iterator>, detail::__iter_value_t<base_iterator>>,
+		detail::__iter_difference_t<base_iterator>, void,
+		std::tuple<detail::__iter_difference_t<base_iterator>, detail::__iter_reference_t<base_iterator>>>
+	{
+	public:
+		using self				= iterator;
+		using difference_type	= detail::__iter_difference_t<base_iterator>;
+		using reference			= std::tuple<difference_type, detail::__iter_reference_t<base_iterator>>;
+
+	private:
+		base_iterator	cur{};
+		difference_type	index = 0;
+
+	public:
+		iterator() = default;
+		iterator(base_iterator c, difference_type i) : cur(c), index(i) {}
+
+		reference operator*()const { return reference(index, *cur); }
+		reference operator[](difference_type n)const { return reference(index + n, cur[n]); }
+
+		self& operator++() { ++cur; ++index; return *this; }
+		self operator++(int) { auto temp = *this; ++*this; return temp; }
+		self& operator--() { --cur; --index; return *this; }
+		self operator--(int) { auto temp = *this; --*this; return temp; }
+		self& operator+=(difference_type n) { cur += n; index += n; return *this; }
+		self& operator-=(difference_type n) { cur -= n; index -= n; return *this; }
+		self operator+(difference_type n)const { return self(cur + n, index + n); }
+		self operator-(difference_type n)const { return self(cur - n, index - n); }
+		difference_type operator-(const self& rhs)const { return cur - rhs.cur; }
+
+		bool operator==(const self& rhs)const { return cur == rhs.cur; }
+		bool operator!=(const self& rhs)const { return cur != rhs.cur; }
+		bool operator<(const self& rhs)const { return cur < rhs.cur; }
+		bool operator<=(const self& rhs)const { return cur <= rhs.cur; }
+		bool operator>(const self& rhs)const { return cur > rhs.cur; }
+		bool operator>=(const self& rhs)const { return cur >= rhs.cur; }
+	};
+
+public:
+	explicit enumerate_view(View v) : base(std::move(v)) {}
+
+	iterator begin()const { return iterator(base.begin(), 0); }
+
+	iterator end()const
+	{
+		if constexpr (random_access) return iterator(base.end(), base.end() - base.begin());
+		else return iterator(base.end(), 0);	// 比较只看底层迭代器
+	}
+};
+
+
+namespace detail {
+	struct __filter_fn
+	{
+		template<class Range, class Pred>
+		auto operator()(Range&& r, Pred pred)const
+		{
+			return filter_view<__all_t<Range>, Pred>(__all(std::forward<Range>(r)), std::move(pred));
+		}
+
+		template<class Pred>
+		auto operator()(Pred pred)const
+		{
+			return __make_closure([pred = std::move(pred)](auto&& r) {
+				return __filter_fn()(std::forward<decltype(r)>(r), pred);
+			});
+		}
+	};
+
+	struct __transform_fn
+	{
+		template<class Range, class Function>
+		auto operator()(Range&& r, Function f)const
+		{
+			return transform_view<__all_t<Range>, Function>(__all(std::forward<Range>(r)), std::move(f));
+		}
+
+		template<class Function>
+		auto operator()(Function f)const
+		{
+			return __make_closure([f = std::move(f)](auto&& r) {
+				return __transform_fn()(std::forward<decltype(r)>(r), f);
+			});
+		}
+	};
+
+	// take, drop, chunk 的公共形式
+	template<template<class> class View>
+	struct __count_fn
+	{
+		template<class Range>
+		auto operator()(Range&& r, ptrdiff_t n)const
+		{
+			return View<__all_t<Range>>(__all(std::forward<Range>(r)), n);
+		}
+
+		auto operator()(ptrdiff_t n)const
+		{
+			return __make_closure([n](auto&& r) {
+				return __count_fn()(std::forward<decltype(r)>(r), n);
+			});
+		}
+	};
+
+	struct __zip_fn
+	{
+		template<class... Ranges>
+		auto operator()(Ranges&&... rs)const
+		{
+			static_assert(sizeof...(Ranges) > 0, "views::zip requires at least one range");
+			return zip_view<__all_t<Ranges>...>(__all(std::forward<Ranges>(rs))...);
+		}
+	};
+
+	struct __enumerate_fn
+	{
+		template<class Range>
+		auto operator()(Range&& r)const
+		{
+			return enumerate_view<__all_t<Range>>(__all(std::forward<Range>(r)));
+		}
+	};
+}
+
+
+namespace views {
+	inline constexpr detail::__filter_fn							filter{};
+	inline constexpr detail::__transform_fn							transform{};
+	inline constexpr detail::__count_fn<take_view>					take{};
+	inline constexpr detail::__count_fn<drop_view>					drop{};
+	inline constexpr detail::__count_fn<chunk_view>					chunk{};
+	inline constexpr detail::__zip_fn								zip{};
+	inline constexpr detail::__range_adaptor_closure<detail::__enumerate_fn>	enumerate{};
+}
+
+SX_NAMESPACE_END
+#endif	// end define _SX_VIEWS_H_
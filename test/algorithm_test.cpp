@@ -0,0 +1,92 @@
+﻿/**************************************************
+ * @brief   : sx_algorithm.h 的行为测试
+ * @file    : algorithm_test.cpp
+ * @author  : 宋旭
+ * @date    : 2026年10月19日，04:08:51
+ **************************************************/
+
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <utility>
+#include <vector>
+#include "sx_algorithm.h"
+#include "sx_test.h"
+
+namespace {
+	std::vector<int> random_sorted(size_t n, unsigned seed)
+	{
+		std::mt19937 rng(seed);
+		std::vector<int> v(n);
+		for (int& x : v) x = static_cast<int>(rng() % 1000);
+		std::sort(v.begin(), v.end());
+		return v;
+	}
+
+	void test_merge()
+	{
+		std::vector<int> a = random_sorted(100, 1), b = random_sorted(37, 2);
+		std::vector<int> out(a.size() + b.size()), expect(out.size());
+		std::merge(a.begin(), a.end(), b.begin(), b.end(), expect.begin());
+		SX_CHECK(sx::merge(a.begin(), a.end(), b.begin(), b.end(), out.begin()) == out.end());
+		SX_CHECK(out == expect);
+
+		// 稳定性：相等时先取第一个序列的元素
+		std::vector<std::pair<int, int>> x{ { 1, 0 }, { 2, 0 } }, y{ { 1, 1 }, { 2, 1 } }, z(4);
+		auto by_first = [](const auto& l, const auto& r) { return l.first < r.first; };
+		sx::merge(x.begin(), x.end(), y.begin(), y.end(), z.begin(), by_first);
+		SX_CHECK(z[0].second == 0 && z[1].second == 1 && z[2].second == 0 && z[3].second == 1);
+	}
+
+	void test_inplace_merge()
+	{
+		std::vector<int> a = random_sorted(64, 3), b = random_sorted(200, 4);
+		std::vector<int> v(a);
+		v.insert(v.end(), b.begin(), b.end());
+		std::vector<int> expect(v);
+		std::sort(expect.begin(), expect.end());
+		sx::inplace_merge(v.begin(), v.begin() + 64, v.end());
+		SX_CHECK(v == expect);
+	}
+
+	void test_merge_runs()
+	{
+		std::vector<std::vector<int>> data;
+		std::vector<int> expect;
+		for (unsigned i = 0; i < 9; ++i)
+		{
+			data.push_back(random_sorted(i * 13, 10 + i));
+			expect.insert(expect.end(), data.back().begin(), data.back().end());
+		}
+		std::sort(expect.begin(), expect.end());
+
+		using iterator = std::vector<int>::const_iterator;
+		std::vector<std::pair<iterator, iterator>> runs;
+		for (const auto& d : data) runs.emplace_back(d.begin(), d.end());
+		std::vector<int> out(expect.size());
+		SX_CHECK(sx::merge_runs(runs.begin(), runs.end(), out.begin()) == out.end());
+		SX_CHECK(out == expect);
+	}
+
+	void test_parallel_merge()
+	{
+		std::vector<int> a = random_sorted(200000, 5), b = random_sorted(150000, 6);
+		std::vector<int> out(a.size() + b.size()), expect(out.size());
+		std::merge(a.begin(), a.end(), b.begin(), b.end(), expect.begin());
+		for (size_t threads : { size_t(1), size_t(3), size_t(8) })
+		{
+			std::fill(out.begin(), out.end(), -1);
+			SX_CHECK(sx::parallel_merge(a.begin(), a.end(), b.begin(), b.end(), out.begin(), std::less<>(), threads) == out.end());
+			SX_CHECK(out == expect);
+		}
+	}
+}
+
+int main()
+{
+	test_merge();
+	test_inplace_merge();
+	test_merge_runs();
+	test_parallel_merge();
+	return sx_test::report("algorithm");
+}
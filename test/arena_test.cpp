@@ -0,0 +1,86 @@
+﻿/**************************************************
+ * @brief   : sx_arena.h 的行为测试
+ * @file    : arena_test.cpp
+ * @author  : 宋旭
+ * @date    : 2026年10月19日，04:11:26
+ **************************************************/
+
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include "sx_arena.h"
+#include "sx_test.h"
+
+namespace {
+	// 记录申请与归还的字节数
+	struct counting_backend
+	{
+		size_t* live;
+
+		void* allocate(size_t bytes) { *live += bytes; return ::operator new(bytes); }
+		void deallocate(void* p, size_t bytes)noexcept { *live -= bytes; ::operator delete(p, bytes); }
+	};
+
+	void test_allocate()
+	{
+		sx::arena a(1024);
+		char* p = static_cast<char*>(a.allocate(10, 1));
+		char* q = static_cast<char*>(a.allocate(10, 1));
+		SX_CHECK(q == p + 10);
+
+		void* aligned = a.allocate(8, 64);
+		SX_CHECK(reinterpret_cast<uintptr_t>(aligned) % 64 == 0);
+
+		// 超过块大小的请求单独成块
+		void* big = a.allocate(4096);
+		std::memset(big, 0xab, 4096);
+		SX_CHECK(a.bytes_reserved() >= 1024 + 4096);
+
+		int* x = a.create<int>(42);
+		SX_CHECK(*x == 42);
+	}
+
+	void test_release()
+	{
+		size_t live = 0;
+		{
+			sx::basic_arena<counting_backend> a(256, counting_backend{ &live });
+			for (int i = 0; i < 100; ++i) a.allocate(100);
+			SX_CHECK(live == a.bytes_reserved());
+			SX_CHECK(live > 0);
+		}
+		SX_CHECK(live == 0);
+	}
+
+	void test_concurrent()
+	{
+		sx::arena a(512);
+		const int threads = 4, per_thread = 5000;
+		std::vector<std::vector<int*>> results(threads);
+		std::vector<std::thread> workers;
+		for (int t = 0; t < threads; ++t)
+		{
+			workers.emplace_back([&, t] {
+				for (int i = 0; i < per_thread; ++i) results[t].push_back(a.create<int>(t * per_thread + i));
+			});
+		}
+		for (std::thread& w : workers) w.join();
+
+		// 各线程拿到的内存互不重叠
+		bool intact = true;
+		for (int t = 0; t < threads; ++t)
+		{
+			for (int i = 0; i < per_thread; ++i) intact &= *results[t][i] == t * per_thread + i;
+		}
+		SX_CHECK(intact);
+	}
+}
+
+int main()
+{
+	test_allocate();
+	test_release();
+	test_concurrent();
+	return sx_test::report("arena");
+}
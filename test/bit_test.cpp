@@ -0,0 +1,38 @@
+﻿/**************************************************
+ * @brief   : sx_bit.h 的行为测试
+ * @file    : bit_test.cpp
+ * @author  : 宋旭
+ * @date    : 2026年10月19日，04:13:02
+ **************************************************/
+
+#include <bit>
+#include <cstdint>
+#include <random>
+#include "sx_bit.h"
+#include "sx_test.h"
+
+int main()
+{
+	SX_CHECK(sx::popcount(0) == 0);
+	SX_CHECK(sx::popcount(~uint64_t(0)) == 64);
+	SX_CHECK(sx::countr_zero(0) == 64);
+	SX_CHECK(sx::countl_zero(0) == 64);
+	SX_CHECK(sx::bit_width(0) == 0);
+	SX_CHECK(sx::countr_zero(uint64_t(1) << 63) == 63);
+	SX_CHECK(sx::countl_zero(1) == 63);
+	SX_CHECK(sx::bit_width(uint64_t(1) << 40) == 41);
+
+	// 与标准库的结果一致
+	std::mt19937_64 rng(7);
+	bool same = true;
+	for (int i = 0; i < 10000; ++i)
+	{
+		uint64_t x = rng() >> (rng() % 64);
+		same &= sx::popcount(x) == std::popcount(x);
+		same &= sx::countr_zero(x) == std::countr_zero(x);
+		same &= sx::countl_zero(x) == std::countl_zero(x);
+		same &= sx::bit_width(x) == static_cast<int>(std::bit_width(x));
+	}
+	SX_CHECK(same);
+	return sx_test::report("bit");
+}
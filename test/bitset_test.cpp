@@ -0,0 +1,65 @@
+﻿/**************************************************
+ * @brief   : sx_bitset.h 的行为测试
+ * @file    : bitset_test.cpp
+ * @author  : 宋旭
+ * @date    : 2026年10月19日，04:15:40
+ **************************************************/
+
+#include <stdexcept>
+#include <vector>
+#include "sx_bitset.h"
+#include "sx_test.h"
+
+namespace {
+	void test_bitset()
+	{
+		sx::bitset<130> b;
+		SX_CHECK(b.none() && b.size() == 130);
+		b.set(0).set(64).set(129);
+		SX_CHECK(b.count() == 3 && b.test(64) && !b.test(65));
+		SX_CHECK(b.find_first() == 0 && b.find_next(0) == 64 && b.find_next(64) == 129 && b.find_next(129) == 130);
+		SX_CHECK_THROWS(b.test(130), std::out_of_range);
+
+		// set() 与 flip() 不改变超出 size() 的位
+		b.set();
+		SX_CHECK(b.all() && b.count() == 130);
+		b.flip();
+		SX_CHECK(b.none());
+
+		sx::bitset<70> x(0b1100), y(0b1010);
+		SX_CHECK((x & y) == sx::bitset<70>(0b1000));
+		SX_CHECK((x | y) == sx::bitset<70>(0b1110));
+		SX_CHECK((x ^ y) == sx::bitset<70>(0b0110));
+		SX_CHECK((~x).count() == 68);
+	}
+
+	void test_dynamic_bitset()
+	{
+		sx::dynamic_bitset d(100, true);
+		SX_CHECK(d.count() == 100 && d.all());
+		d.resize(200, false);
+		SX_CHECK(d.count() == 100 && !d.test(150));
+		d.resize(250, true);
+		SX_CHECK(d.count() == 150 && d.test(249));
+		d.reset(5);
+		d.push_back(true);
+		SX_CHECK(d.size() == 251 && d.test(250) && !d.test(5));
+
+		sx::dynamic_bitset e(10);
+		e[1] = true;
+		e[7] = true;
+		std::vector<size_t> bits;
+		for (size_t i : e.set_bits()) bits.push_back(i);
+		SX_CHECK((bits == std::vector<size_t>{ 1, 7 }));
+
+		sx::dynamic_bitset f(11);
+		SX_CHECK_THROWS(e &= f, std::invalid_argument);
+	}
+}
+
+int main()
+{
+	test_bitset();
+	test_dynamic_bitset();
+	return sx_test::report("bitset");
+}
@@ -0,0 +1,74 @@
+﻿/**************************************************
+ * @brief   : sx_bloom_filter.h 的行为测试
+ * @file    : bloom_filter_test.cpp
+ * @author  : 宋旭
+ * @date    : 2026年10月19日，04:19:33
+ **************************************************/
+
+#include <stdexcept>
+#include "sx_bloom_filter.h"
+#include "sx_test.h"
+
+namespace {
+	void test_bloom_filter()
+	{
+		sx::bloom_filter<int> f(10000, 0.01);
+		for (int i = 0; i < 10000; ++i) f.insert(i);
+
+		bool no_false_negative = true;
+		for (int i = 0; i < 10000; ++i) no_false_negative &= f.contains(i);
+		SX_CHECK(no_false_negative);
+
+		int false_positives = 0;
+		for (int i = 10000; i < 110000; ++i) false_positives += f.contains(i);
+		SX_CHECK(false_positives < 2000);	// 期望约 1%，留出余量
+
+		sx::bloom_filter<int> g = sx::bloom_filter<int>::with_blocks(f.block_count());
+		g.insert(-5);
+		f.merge(g);
+		SX_CHECK(f.contains(-5));
+		SX_CHECK_THROWS(f.merge(sx::bloom_filter<int>::with_blocks(f.block_count() + 1)), std::invalid_argument);
+		SX_CHECK_THROWS(sx::bloom_filter<int>(10, 1.5), std::invalid_argument);
+
+		f.clear();
+		SX_CHECK(!f.contains(1));
+	}
+
+	void test_quotient_filter()
+	{
+		sx::quotient_filter<int> q(64);
+		const unsigned fingerprint_bits = q.quotient_bits() + q.remainder_bits();
+		for (int i = 0; i < 5000; ++i) q.insert(i);
+		SX_CHECK(q.size() == 5000);
+
+		// 扩容不改变指纹，已插入的元素仍然存在
+		SX_CHECK(q.quotient_bits() + q.remainder_bits() == fingerprint_bits);
+		bool no_false_negative = true;
+		for (int i = 0; i < 5000; ++i) no_false_negative &= q.contains(i);
+		SX_CHECK(no_false_negative);
+
+		// 同一个指纹插入两次，删除一次后仍然存在
+		q.insert(7);
+		SX_CHECK(q.erase(7) && q.contains(7));
+		SX_CHECK(q.erase(7));
+
+		for (int i = 0; i < 5000; ++i)
+		{
+			if (i != 7) q.erase(i);
+		}
+		SX_CHECK(q.empty());
+		SX_CHECK(!q.contains(1));
+
+		sx::quotient_filter<int> r(64);
+		r.insert(100);
+		q.merge(r);
+		SX_CHECK(q.contains(100) && q.size() == 1);
+	}
+}
+
+int main()
+{
+	test_bloom_filter();
+	test_quotient_filter();
+	return sx_test::report("bloom_filter");
+}
@@ -0,0 +1,103 @@
+﻿/**************************************************
+ * @brief   : sx_coroutine.h 的行为测试
+ * @file    : coroutine_test.cpp
+ * @author  : 宋旭
+ * @date    : 2026年10月19日，04:23:05
+ **************************************************/
+
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "sx_coroutine.h"
+#include "sx_test.h"
+
+namespace {
+	sx::task<int> answer() { co_return 42; }
+
+	sx::task<int> add(int a, int b)
+	{
+		int x = co_await answer();
+		co_return x + a + b;
+	}
+
+	sx::task<void> fail() { throw std::runtime_error("fail"); co_return; }
+
+	sx::task<int> await_empty()
+	{
+		sx::task<int> empty;
+		co_return co_await empty;
+	}
+
+	// 逐层嵌套的 co_await，结果沿对称转移逐层返回
+	sx::task<long> sum_to(long n)
+	{
+		if (n == 0) co_return 0;
+		co_return n + co_await sum_to(n - 1);
+	}
+
+	sx::generator<int> fibonacci(int n)
+	{
+		int a = 0, b = 1;
+		for (int i = 0; i < n; ++i)
+		{
+			co_yield a;
+			int c = a + b;
+			a = b;
+			b = c;
+		}
+	}
+
+	/**
+	 * 线程的帧池析构后分配的帧交给另一个线程释放，被该线程的池缓存，
+	 * 再次分配同一类别的最大尺寸时必须仍在原内存块之内(由 AddressSanitizer 检查)
+	 * 使用其他测试不会用到的大小类别，保证该类别的缓存未满
+	 */
+	void* late_frame = nullptr;
+
+	struct late_allocator
+	{
+		~late_allocator() { late_frame = sx::detail::__pooled_promise::operator new(1281); }
+	};
+
+	void test_frame_after_pool_teardown()
+	{
+		std::thread([] {
+			thread_local late_allocator late;	// 先于帧池构造，因此在帧池之后析构
+			(void)late;
+			sx::sync_wait(answer());
+		}).join();
+		SX_CHECK(late_frame != nullptr);
+
+		sx::detail::__pooled_promise::operator delete(late_frame, 1281);
+		void* p = sx::detail::__pooled_promise::operator new(1344);
+		SX_CHECK(p == late_frame);
+		std::memset(p, 0, 1344);
+		sx::detail::__pooled_promise::operator delete(p, 1344);
+	}
+}
+
+// 线程退出后才析构的 task 不能访问已销毁的帧池
+sx::task<int> global_task;
+
+int main()
+{
+	SX_CHECK(sx::sync_wait(answer()) == 42);
+	SX_CHECK(sx::sync_wait(add(1, 2)) == 45);
+	SX_CHECK(sx::sync_wait(sum_to(1000)) == 500500L);
+	SX_CHECK_THROWS(sx::sync_wait(fail()), std::runtime_error);
+	SX_CHECK_THROWS(sx::sync_wait(await_empty()), std::logic_error);
+
+	std::vector<int> fib;
+	for (int x : fibonacci(10)) fib.push_back(x);
+	SX_CHECK((fib == std::vector<int>{ 0, 1, 1, 2, 3, 5, 8, 13, 21, 34 }));
+
+	int result = 0;
+	std::thread([&] { result = sx::sync_wait(add(0, 0)); }).join();
+	SX_CHECK(result == 42);
+
+	test_frame_after_pool_teardown();
+
+	global_task = answer();
+	return sx_test::report("coroutine");
+}
@@ -0,0 +1,55 @@
+﻿/**************************************************
+ * @brief   : sx_frozen_map.h 的行为测试
+ * @file    : frozen_map_test.cpp
+ * @author  : 宋旭
+ * @date    : 2026年10月19日，04:26:48
+ **************************************************/
+
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include "sx_frozen_map.h"
+#include "sx_test.h"
+
+namespace {
+	constexpr auto methods = sx::make_frozen_map<std::string_view, int>({
+		{ "GET", 1 }, { "POST", 2 }, { "PUT", 3 }, { "DELETE", 4 }, { "HEAD", 5 } });
+	static_assert(methods.size() == 5);
+	static_assert(methods.at("PUT") == 3);
+	static_assert(!methods.contains("PATCH"));
+
+	constexpr auto primes = sx::make_frozen_set<int>({ 2, 3, 5, 7, 11, 13, 17, 19, 23, 29 });
+	static_assert(primes.contains(29) && !primes.contains(9));
+
+	// 较大的集合也能在编译期构造
+	template<size_t... I>
+	constexpr auto make_large(std::index_sequence<I...>)
+	{
+		constexpr int keys[] = { static_cast<int>(I * 7919 + 3)... };
+		return sx::make_frozen_set(keys);
+	}
+	constexpr auto large = make_large(std::make_index_sequence<2000>());
+	static_assert(large.contains(3) && large.contains(1999 * 7919 + 3) && !large.contains(4));
+
+	constexpr auto empty_map = sx::make_frozen_map<int, int>();
+	static_assert(empty_map.empty() && !empty_map.contains(0) && empty_map.begin() == empty_map.end());
+}
+
+int main()
+{
+	// 运行期查找与编译期结果一致
+	std::string_view key = "DELETE";
+	SX_CHECK(methods.at(key) == 4);
+	SX_CHECK(methods.find("OPTIONS") == methods.end());
+	SX_CHECK_THROWS(methods.at("OPTIONS"), std::out_of_range);
+	SX_CHECK_THROWS(empty_map.at(1), std::out_of_range);
+
+	int found = 0;
+	for (int i = 0; i < 2000; ++i) found += large.count(i * 7919 + 3);
+	SX_CHECK(found == 2000);
+
+	int sum = 0;
+	for (const auto& kv : methods) sum += kv.second;
+	SX_CHECK(sum == 15);
+	return sx_test::report("frozen_map");
+}
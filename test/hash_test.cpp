@@ -0,0 +1,54 @@
+﻿/**************************************************
+ * @brief   : sx_hash.h 的行为测试
+ * @file    : hash_test.cpp
+ * @author  : 宋旭
+ * @date    : 2026年10月19日，04:29:14
+ **************************************************/
+
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include "sx_hash.h"
+#include "sx_test.h"
+
+int main()
+{
+	// 相同输入得到相同结果，种子改变结果
+	const char text[] = "the quick brown fox jumps over the lazy dog";
+	const size_t len = sizeof(text) - 1;
+	SX_CHECK(sx::hash_bytes(text, len) == sx::hash_bytes(std::string(text).data(), len));
+	SX_CHECK(sx::hash_bytes(text, len, 1) != sx::hash_bytes(text, len, 2));
+	SX_CHECK(sx::hash_mix(1) != sx::hash_mix(2));
+
+	// 每种长度(覆盖所有分支)翻转任一字节都改变结果
+	bool sensitive = true;
+	unsigned char buffer[300];
+	for (size_t i = 0; i < sizeof(buffer); ++i) buffer[i] = static_cast<unsigned char>(i * 31);
+	for (size_t n = 1; n <= sizeof(buffer); ++n)
+	{
+		const uint64_t h = sx::hash_bytes(buffer, n);
+		for (size_t i = 0; i < n; ++i)
+		{
+			buffer[i] ^= 1;
+			sensitive &= sx::hash_bytes(buffer, n) != h;
+			buffer[i] ^= 1;
+		}
+	}
+	SX_CHECK(sensitive);
+
+	// 长度是输入的一部分：前缀不与整体碰撞
+	SX_CHECK(sx::hash_bytes(buffer, 16) != sx::hash_bytes(buffer, 17));
+
+	// string 与 string_view 的结果一致，可用于异构查找
+	SX_CHECK(sx::hash<std::string>()(std::string("abc")) == sx::hash<std::string_view>()("abc"));
+
+	// 连续整数不碰撞
+	std::unordered_set<size_t> seen;
+	for (int i = 0; i < 100000; ++i) seen.insert(sx::hash<int>()(i));
+	SX_CHECK(seen.size() == 100000);
+
+	SX_CHECK(sx::hash_combine(1, 2) != sx::hash_combine(2, 1));
+	SX_CHECK((sx::hash<sx::pair<int, int>>()(sx::pair<int, int>(1, 2)) != sx::hash<sx::pair<int, int>>()(sx::pair<int, int>(2, 1))));
+	return sx_test::report("hash");
+}
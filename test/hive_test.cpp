@@ -0,0 +1,111 @@
+﻿/**************************************************
+ * @brief   : sx_hive.h 的行为测试
+ * @file    : hive_test.cpp
+ * @author  : 宋旭
+ * @date    : 2026年10月19日，04:37:22
+ **************************************************/
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "sx_hive.h"
+#include "sx_test.h"
+
+namespace {
+	// 第 budget 次复制时抛出异常
+	struct bomb
+	{
+		static inline int budget = 1000000;
+		static inline int live = 0;
+		std::string text;
+
+		explicit bomb(int v) : text(40, char('a' + v % 26)) { ++live; }
+		bomb(const bomb& rhs) : text(rhs.text)
+		{
+			if (--budget < 0) throw std::runtime_error("bomb");
+			++live;
+		}
+		~bomb() { --live; }
+	};
+
+	// 复制中途抛出异常时不泄漏已复制的元素与块(由 LeakSanitizer 检查)，插入失败后 hive 仍然可用
+	void test_exception_safety()
+	{
+		using bomb_hive = sx::hive<bomb>;
+		{
+			bomb_hive h;
+			for (int i = 0; i < 100; ++i) h.emplace(i);
+
+			bomb::budget = 50;
+			SX_CHECK_THROWS(bomb_hive(h), std::runtime_error);
+			SX_CHECK(bomb::live == 100);
+
+			const bomb& first = *h.begin();
+			bomb::budget = 0;
+			SX_CHECK_THROWS(h.insert(first), std::runtime_error);
+			bomb::budget = 1000000;
+			SX_CHECK(h.size() == 100);
+
+			for (int i = 0; i < 50; ++i) h.emplace(i);
+			size_t n = 0;
+			for (const bomb& b : h) n += b.text.size() == 40;
+			SX_CHECK(n == 150 && h.size() == 150);
+		}
+		SX_CHECK(bomb::live == 0);
+	}
+}
+
+int main()
+{
+	test_exception_safety();
+
+	sx::hive<int> h;
+	std::vector<int*> pointers;
+	for (int i = 0; i < 1000; ++i) pointers.push_back(&*h.insert(i));
+	SX_CHECK(h.size() == 1000);
+
+	// 删除偶数，其余元素的地址不变
+	for (int i = 0; i < 1000; i += 2) h.erase(h.get_iterator(pointers[i]));
+	SX_CHECK(h.size() == 500);
+	bool stable = true;
+	for (int i = 1; i < 1000; i += 2) stable &= *pointers[i] == i;
+	SX_CHECK(stable);
+
+	// 遍历跳过所有空洞，正向与反向一致
+	std::vector<int> forward;
+	for (int x : h) forward.push_back(x);
+	std::sort(forward.begin(), forward.end());
+	bool odd = forward.size() == 500;
+	for (size_t i = 0; i < forward.size() && odd; ++i) odd = forward[i] == static_cast<int>(2 * i + 1);
+	SX_CHECK(odd);
+	size_t backward = 0;
+	for (auto it = h.end(); it != h.begin();)
+	{
+		--it;
+		++backward;
+	}
+	SX_CHECK(backward == 500);
+
+	// 被删除的槽被复用，容量不增长
+	const size_t capacity = h.capacity();
+	for (int i = 0; i < 500; ++i) h.insert(-i);
+	SX_CHECK(h.size() == 1000 && h.capacity() == capacity);
+
+	sx::hive<int> copy(h);
+	SX_CHECK(copy.size() == 1000);
+	h.clear();
+	SX_CHECK(h.empty() && h.begin() == h.end() && copy.size() == 1000);
+
+	// 元素的析构函数被调用
+	auto counter = std::make_shared<int>(0);
+	{
+		sx::hive<std::shared_ptr<int>> owners;
+		for (int i = 0; i < 100; ++i) owners.insert(counter);
+		owners.erase(owners.begin());
+		SX_CHECK(counter.use_count() == 100);
+	}
+	SX_CHECK(counter.use_count() == 1);
+	return sx_test::report("hive");
+}
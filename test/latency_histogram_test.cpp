@@ -0,0 +1,63 @@
+﻿/**************************************************
+ * @brief   : sx_latency_histogram.h 的行为测试
+ * @file    : latency_histogram_test.cpp
+ * @author  : 宋旭
+ * @date    : 2026年10月19日，04:41:09
+ **************************************************/
+
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "sx_latency_histogram.h"
+#include "sx_test.h"
+
+int main()
+{
+	sx::latency_histogram h;
+	SX_CHECK(h.snapshot().empty());
+
+	for (uint64_t i = 1; i <= 1000; ++i) h.record(i * 1000);
+	sx::histogram_snapshot s = h.snapshot();
+	SX_CHECK(s.count() == 1000);
+	SX_CHECK(s.min() == 1000 && s.max() == 1000000);
+	SX_CHECK(s.mean() > 500000.0 && s.mean() < 501000.0);
+
+	// 分位数的相对误差在桶宽以内
+	const uint64_t p50 = s.percentile(50.0), p99 = s.percentile(99.0);
+	SX_CHECK(p50 > 480000 && p50 < 520000);
+	SX_CHECK(p99 > 960000 && p99 < 1020000);
+
+	// 多线程写入各自的分片，快照合并全部分片
+	std::vector<std::thread> workers;
+	for (int t = 0; t < 4; ++t)
+	{
+		workers.emplace_back([&h] {
+			for (int i = 0; i < 1000; ++i) h.record(std::chrono::microseconds(5));
+		});
+	}
+	for (std::thread& w : workers) w.join();
+	sx::histogram_snapshot all = h.snapshot();
+	SX_CHECK(all.count() == 5000);
+
+	// 两次快照之差只包含期间的记录
+	sx::histogram_snapshot delta = all;
+	delta -= s;
+	SX_CHECK(delta.count() == 4000);
+	SX_CHECK((s + delta).count() == all.count());
+
+	{
+		sx::scoped_timer timer(h);
+	}
+	SX_CHECK(h.snapshot().count() == 5001);
+
+	// 短生命周期的直方图析构后，线程缓存中它们的项被清除，长期存在的直方图的计数不受影响
+	for (int i = 0; i < 1000; ++i)
+	{
+		sx::latency_histogram temporary;
+		temporary.record(1);
+		h.record(2);
+	}
+	SX_CHECK(sx::detail::__hist_thread_cache::local().entries.size() <= 2);
+	SX_CHECK(h.snapshot().count() == 6001);
+	return sx_test::report("latency_histogram");
+}
@@ -0,0 +1,76 @@
+﻿/**************************************************
+ * @brief   : sx_lru_cache.h 的行为测试
+ * @file    : lru_cache_test.cpp
+ * @author  : 宋旭
+ * @date    : 2026年10月19日，04:44:36
+ **************************************************/
+
+#include <string>
+#include "sx_lru_cache.h"
+#include "sx_test.h"
+
+namespace {
+	struct length_weigher
+	{
+		size_t operator()(const int&, const std::string& s)const noexcept { return s.size(); }
+	};
+
+	void test_lru()
+	{
+		sx::lru_cache<int, std::string> c(2);
+		c.put(1, "one");
+		c.put(2, "two");
+		SX_CHECK(c.get(1) != nullptr);	// 1 成为最近使用
+		c.put(3, "three");				// 淘汰 2
+		SX_CHECK(!c.contains(2) && c.contains(1) && c.contains(3));
+		SX_CHECK(c.stats().hits == 1 && c.stats().evictions == 1);
+		SX_CHECK(c.get(2) == nullptr && c.stats().misses == 1);
+
+		// peek 不改变顺序
+		SX_CHECK(*c.peek(1) == "one");
+		c.put(4, "four");				// 淘汰 1
+		SX_CHECK(!c.contains(1));
+
+		// value 引用缓存中即将被淘汰的值
+		c.put(5, *c.peek(3));
+		SX_CHECK(*c.peek(5) == "three");
+
+		SX_CHECK(c.erase(5) && !c.erase(5) && c.size() == 1);
+		c.clear();
+		SX_CHECK(c.empty());
+	}
+
+	void test_clock()
+	{
+		sx::clock_cache<int, std::string> c(3);
+		for (int i = 0; i < 3; ++i) c.put(i, std::to_string(i));
+		c.get(0);
+		c.get(1);
+		c.put(3, "3");					// 2 未被访问，最先淘汰
+		SX_CHECK(!c.contains(2) && c.contains(0) && c.contains(1) && c.contains(3));
+		c.put(4, *c.get(0));
+		SX_CHECK(c.size() == 3 && *c.peek(4) == "0");
+	}
+
+	void test_weigher()
+	{
+		sx::lru_cache<int, std::string, sx::hash<int>, std::equal_to<int>, length_weigher> c(10);
+		c.put(1, "aaaa");
+		c.put(2, "bbbb");
+		SX_CHECK(c.weight() == 8);
+		c.put(3, "cccc");				// 超出容量，淘汰 1
+		SX_CHECK(!c.contains(1) && c.weight() == 8);
+		SX_CHECK(!c.put(4, std::string(11, 'x')) && !c.contains(4));
+
+		c.set_capacity(4);
+		SX_CHECK(c.size() == 1 && c.contains(3));
+	}
+}
+
+int main()
+{
+	test_lru();
+	test_clock();
+	test_weigher();
+	return sx_test::report("lru_cache");
+}
@@ -0,0 +1,51 @@
+﻿/**************************************************
+ * @brief   : sx_mmap_vector.h 的行为测试
+ * @file    : mmap_vector_test.cpp
+ * @author  : 宋旭
+ * @date    : 2026年10月19日，04:48:12
+ **************************************************/
+
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+#include "sx_mmap_vector.h"
+#include "sx_test.h"
+
+int main()
+{
+	const std::string path = "/tmp/sx_mmap_vector_test." + std::to_string(::getpid());
+	{
+		sx::mmap_vector<int> v(path.c_str(), sx::mmap_open_mode::create_truncate);
+		for (int i = 0; i < 10000; ++i) v.push_back(i);
+		v.append(v.data(), 100);		// 源区间位于映射区内，扩容时仍然有效
+		SX_CHECK(v.size() == 10100 && v[10099] == 99);
+		v.resize(20000, 7);
+		SX_CHECK(v.size() == 20000 && v.back() == 7);
+		v.resize(10100);
+		v.shrink_to_fit();
+		v.flush();
+	}
+	{
+		// 重新打开后数据仍在
+		sx::mmap_vector<int> v(path.c_str(), sx::mmap_open_mode::read_only);
+		SX_CHECK(v.size() == 10100 && v[5000] == 5000 && v[10050] == 50);
+		SX_CHECK_THROWS(v.push_back(1), std::logic_error);
+		SX_CHECK_THROWS(v.shrink_to_fit(), std::logic_error);
+		SX_CHECK(v.size() == 10100);
+	}
+	{
+		sx::mmap_vector<int> v(path.c_str());
+		v.clear();
+		v.push_back(1);
+	}
+	{
+		sx::mmap_vector<int> v(path.c_str(), sx::mmap_open_mode::read_only);
+		SX_CHECK(v.size() == 1 && v[0] == 1);
+	}
+	std::remove(path.c_str());
+
+	sx::mmap_vector<int> closed;
+	SX_CHECK(closed.empty());
+	return sx_test::report("mmap_vector");
+}
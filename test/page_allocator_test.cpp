@@ -0,0 +1,38 @@
+﻿/**************************************************
+ * @brief   : sx_page_allocator.h 的行为测试
+ * @file    : page_allocator_test.cpp
+ * @author  : 宋旭
+ * @date    : 2026年10月19日，04:51:40
+ **************************************************/
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "sx_arena.h"
+#include "sx_page_allocator.h"
+#include "sx_test.h"
+
+int main()
+{
+	sx::page_allocator pages;
+	const size_t bytes = pages.mapped_size(100);
+	SX_CHECK(bytes >= 100);
+	void* p = pages.allocate(100);
+	SX_CHECK(reinterpret_cast<uintptr_t>(p) % 4096 == 0);
+	std::memset(p, 0xcd, bytes);
+	pages.deallocate(p, 100);
+
+	// 透明大页按 2MB 映射，arena 的块扩大到占满整个映射
+	sx::basic_arena<sx::page_allocator> a;
+	for (int i = 0; i < 1000; ++i) a.allocate(1024);
+	SX_CHECK(a.bytes_reserved() == size_t(2) << 20);
+
+	sx::page_allocator small(sx::huge_page_policy::none);
+	SX_CHECK(small.mapped_size(100) < (size_t(2) << 20));
+	SX_CHECK(small != pages);
+
+	std::vector<int, sx::page_allocator_adaptor<int>> v;
+	for (int i = 0; i < 100000; ++i) v.push_back(i);
+	SX_CHECK(v[99999] == 99999);
+	return sx_test::report("page_allocator");
+}
@@ -0,0 +1,122 @@
+﻿/**************************************************
+ * @brief   : sx_priority_queue.h 的行为测试
+ * @file    : priority_queue_test.cpp
+ * @author  : 宋旭
+ * @date    : 2026年10月19日，04:55:03
+ **************************************************/
+
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "sx_priority_queue.h"
+#include "sx_test.h"
+
+namespace {
+	// radix_heap 只接受 bool 以外的整数键
+	template<class Key, class = void>
+	struct __radix_key : std::false_type {};
+	template<class Key>
+	struct __radix_key<Key, std::void_t<sx::radix_heap<Key, int>>> : std::true_type {};
+	static_assert(__radix_key<int>::value && __radix_key<unsigned char>::value);
+	static_assert(!__radix_key<bool>::value && !__radix_key<double>::value);
+
+	std::vector<int> random_values(size_t n)
+	{
+		std::mt19937 rng(3);
+		std::vector<int> v(n);
+		for (int& x : v) x = static_cast<int>(rng() % 10000) - 5000;
+		return v;
+	}
+
+	void test_priority_queue()
+	{
+		std::vector<int> values = random_values(1000);
+		sx::priority_queue<int> q(values.begin(), values.end());
+		std::sort(values.begin(), values.end(), std::greater<int>());
+		std::vector<int> out;
+		while (!q.empty()) out.push_back(q.take());
+		SX_CHECK(out == values);
+
+		sx::priority_queue<std::string, std::vector<std::string>, std::greater<std::string>, 2> strings;
+		strings.push("b");
+		strings.emplace(1, 'a');
+		strings.push("c");
+		SX_CHECK(strings.top() == "a" && strings.size() == 3);
+	}
+
+	void test_pairing_heap()
+	{
+		sx::pairing_heap<int, std::greater<int>> h;
+		auto h10 = h.push(10);
+		auto h20 = h.push(20);
+		h.push(5);
+		SX_CHECK(h.top() == 5);
+		h.decrease_key(h20, 1);
+		SX_CHECK(h.top() == 1);
+		h.erase(h10);
+		SX_CHECK(h.size() == 2);
+
+		sx::pairing_heap<int, std::greater<int>> other;
+		other.push(3);
+		h.merge(other);
+		SX_CHECK(other.empty() && h.size() == 3);
+
+		std::vector<int> out;
+		while (!h.empty()) out.push_back(h.take());
+		SX_CHECK((out == std::vector<int>{ 1, 3, 5 }));
+	}
+
+	void test_radix_heap()
+	{
+		sx::radix_heap<int, int> h;
+		std::vector<int> values = random_values(1000);
+		for (size_t i = 0; i < values.size(); ++i) h.push(values[i], static_cast<int>(i));
+		std::sort(values.begin(), values.end());
+		std::vector<int> out;
+		while (!h.empty())
+		{
+			out.push_back(h.top_key());
+			h.pop();
+		}
+		SX_CHECK(out == values);
+
+		// 键不能小于最近一次弹出的键，clear 后重新开始
+		h.clear();
+		h.push(100, 0);
+		h.pop();
+		SX_CHECK_THROWS(h.push(99, 0), std::out_of_range);
+		h.push(100, 1);
+		SX_CHECK(h.top().second == 1);
+
+		// 查看堆顶不改变下界，仍可压入介于上次弹出的键与堆顶之间的键
+		h.clear();
+		h.push(10, 0);
+		h.pop();
+		h.push(50, 1);
+		h.push(40, 2);
+		SX_CHECK(h.top_key() == 40);
+		h.push(20, 3);
+		h.push(10, 4);
+		SX_CHECK(h.top().second == 4);
+		std::vector<int> order;
+		while (!h.empty())
+		{
+			order.push_back(h.top_key());
+			h.pop();
+		}
+		SX_CHECK((order == std::vector<int>{ 10, 20, 40, 50 }));
+		SX_CHECK_THROWS(h.push(49, 0), std::out_of_range);
+	}
+}
+
+int main()
+{
+	test_priority_queue();
+	test_pairing_heap();
+	test_radix_heap();
+	return sx_test::report("priority_queue");
+}
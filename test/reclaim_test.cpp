@@ -0,0 +1,145 @@
+﻿/**************************************************
+ * @brief   : sx_reclaim.h 的行为测试
+ * @file    : reclaim_test.cpp
+ * @author  : 宋旭
+ * @date    : 2026年10月19日，05:02:47
+ **************************************************/
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "sx_reclaim.h"
+#include "sx_test.h"
+
+namespace {
+	struct node
+	{
+		static inline std::atomic<int> live{ 0 };
+		int value;
+
+		explicit node(int v) : value(v) { ++live; }
+		~node() { --live; }
+	};
+
+	void test_epoch()
+	{
+		{
+			sx::epoch_domain domain;
+			node* p = new node(1);
+			{
+				auto g = domain.make_guard();
+				domain.retire(p);
+				// 临界区内的线程停留在旧纪元，p 不会被释放
+				for (int i = 0; i < 4; ++i) domain.collect();
+				SX_CHECK(node::live == 1);
+			}
+			for (int i = 0; i < 4; ++i) domain.collect();
+			SX_CHECK(node::live == 0);
+
+			domain.retire(new node(2));
+		}
+		// 回收域析构时释放剩余的对象
+		SX_CHECK(node::live == 0);
+	}
+
+	void test_hazard_pointer()
+	{
+		sx::hazard_pointer_domain domain;
+		std::atomic<node*> shared{ new node(1) };
+		{
+			auto g = domain.make_guard();
+			node* p = g.protect(shared);
+			domain.retire(shared.exchange(new node(2)));
+			domain.collect();
+			// 被保护的对象不会被释放
+			SX_CHECK(node::live == 2 && p->value == 1);
+		}
+		domain.collect();
+		SX_CHECK(node::live == 1);
+
+		// 每个线程的槽位用尽时抛出异常
+		std::vector<std::unique_ptr<sx::hazard_pointer_domain::guard>> guards;
+		for (size_t i = 0; i < sx::hazard_pointer_domain::slots_per_thread; ++i)
+			guards.push_back(std::make_unique<sx::hazard_pointer_domain::guard>(domain));
+		SX_CHECK_THROWS(domain.make_guard(), std::length_error);
+		guards.clear();
+
+		domain.retire(shared.exchange(nullptr));
+		domain.collect();
+		SX_CHECK(node::live == 0);
+	}
+
+	// 读者不断读取，写者不断替换并回收，读者读到的对象始终有效(由 AddressSanitizer 检查)
+	template<class Domain>
+	void stress()
+	{
+		Domain domain(8);
+		std::atomic<node*> shared{ new node(0) };
+		std::atomic<bool> stop{ false };
+		std::atomic<long> sum{ 0 };
+
+		std::vector<std::thread> readers;
+		for (int t = 0; t < 3; ++t)
+		{
+			readers.emplace_back([&] {
+				long local = 0;
+				while (!stop.load(std::memory_order_relaxed))
+				{
+					auto g = domain.make_guard();
+					local += g.protect(shared)->value;
+				}
+				sum += local;
+			});
+		}
+		for (int i = 1; i <= 20000; ++i) domain.retire(shared.exchange(new node(i)));
+		stop = true;
+		for (std::thread& r : readers) r.join();
+
+		domain.retire(shared.exchange(nullptr));
+		for (int i = 0; i < 4; ++i) domain.collect();
+		SX_CHECK(node::live == 0);
+		SX_CHECK(sum >= 0);
+	}
+}
+
+namespace {
+	/**
+	 * 线程退出时回收的对象，其删除函数构造并析构另一个回收域，
+	 * 并向当前线程尚未绑定的回收域摘除对象
+	 */
+	sx::hazard_pointer_domain* exit_target = nullptr;
+
+	void reentrant_deleter(void* p)
+	{
+		delete static_cast<node*>(p);
+		{
+			sx::epoch_domain temporary;
+			temporary.retire(new node(0));
+		}
+		exit_target->retire(new node(0));
+	}
+
+	void test_reentrant_thread_exit()
+	{
+		sx::hazard_pointer_domain target;
+		exit_target = &target;
+		{
+			sx::hazard_pointer_domain domain(1000);
+			std::thread([&] { domain.retire(new node(1), &reentrant_deleter); }).join();
+			SX_CHECK(node::live == 0);
+		}
+		exit_target = nullptr;
+	}
+}
+
+int main()
+{
+	test_reentrant_thread_exit();
+	test_epoch();
+	test_hazard_pointer();
+	stress<sx::epoch_domain>();
+	stress<sx::hazard_pointer_domain>();
+	return sx_test::report("reclaim");
+}
@@ -0,0 +1,35 @@
+#!/bin/sh
+# 编译并运行 test/ 下的全部 *_test.cpp，默认开启 AddressSanitizer 与 UndefinedBehaviorSanitizer
+#   ./run_tests.sh				运行全部测试
+#   ./run_tests.sh views hive	只运行 views_test.cpp 与 hive_test.cpp
+# 可通过 CXX 与 CXXFLAGS 环境变量替换编译器与编译选项
+
+cd "$(dirname "$0")" || exit 1
+CXX=${CXX:-g++}
+CXXFLAGS=${CXXFLAGS:-"-std=c++20 -Wall -Wextra -O1 -g -fsanitize=address,undefined -fno-sanitize-recover=undefined"}
+OUT=${TMPDIR:-/tmp}/sx_test
+mkdir -p "$OUT" || exit 1
+
+if [ $# -eq 0 ]; then
+	set -- $(ls *_test.cpp | sed 's/_test\.cpp$//')
+fi
+
+failed=""
+for name in "$@"; do
+	# trace_test 需要在开启与关闭 SX_ENABLE_TRACING 时各运行一次
+	defines=""
+	[ "$name" = "trace" ] && defines="-DSX_ENABLE_TRACING"
+	for define in "" $defines; do
+		if $CXX $CXXFLAGS $define -pthread -I../SX_STL "${name}_test.cpp" -o "$OUT/$name" && "$OUT/$name"; then
+			:
+		else
+			failed="$failed $name$define"
+		fi
+	done
+done
+
+if [ -n "$failed" ]; then
+	echo "failed:$failed"
+	exit 1
+fi
+echo "all tests passed"
@@ -0,0 +1,73 @@
+﻿/**************************************************
+ * @brief   : sx_serialize.h 的行为测试
+ * @file    : serialize_test.cpp
+ * @author  : 宋旭
+ * @date    : 2026年10月19日，05:09:31
+ **************************************************/
+
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "sx_serialize.h"
+#include "sx_test.h"
+
+namespace {
+	void test_round_trip()
+	{
+		std::map<std::string, std::vector<int>> m{ { "b", { 1, 2, 3 } }, { "a", {} }, { "c", { 42 } } };
+		std::vector<unsigned char> buffer = sx::serialize(m);
+		auto* root = sx::serialized_root<decltype(m)>(buffer.data(), buffer.size());
+
+		SX_CHECK(root->size() == 3);
+		SX_CHECK(root->begin()->first == "a");		// 按键有序
+		SX_CHECK(root->at("b").size() == 3 && root->at("b")[2] == 3);
+		SX_CHECK(root->at("a").empty());
+		SX_CHECK(!root->contains("d"));
+		SX_CHECK_THROWS(root->at("d"), std::out_of_range);
+
+		std::unordered_map<int, std::string> h;
+		for (int i = 0; i < 1000; ++i) h.emplace(i, std::to_string(i * i));
+		buffer = sx::serialize(h);
+		auto* table = sx::serialized_root<decltype(h)>(buffer.data(), buffer.size());
+		bool found = table->size() == 1000;
+		for (int i = 0; i < 1000; ++i) found &= table->at(i) == std::to_string(i * i);
+		SX_CHECK(found);
+		SX_CHECK(table->find(1000) == table->end());
+
+		// 缓冲区可以整体复制到别处后读取
+		std::vector<unsigned char> copy(buffer);
+		SX_CHECK(sx::serialized_root<decltype(h)>(copy.data(), copy.size())->at(999) == "998001");
+	}
+
+	void test_bad_buffer()
+	{
+		std::vector<int> v{ 1, 2, 3 };
+		std::vector<unsigned char> buffer = sx::serialize(v);
+		using root_type = std::vector<int>;
+
+		SX_CHECK_THROWS(sx::serialized_root<root_type>(nullptr, 0), std::invalid_argument);
+		SX_CHECK_THROWS(sx::serialized_root<root_type>(buffer.data(), 8), std::invalid_argument);
+		SX_CHECK_THROWS(sx::serialized_root<root_type>(buffer.data(), buffer.size() - 1), std::invalid_argument);
+
+		// 未对齐的缓冲区
+		std::vector<unsigned char> shifted(buffer.size() + 1);
+		std::memcpy(shifted.data() + 1, buffer.data(), buffer.size());
+		SX_CHECK_THROWS(sx::serialized_root<root_type>(shifted.data() + 1, buffer.size()), std::invalid_argument);
+
+		// 被篡改的魔数
+		std::vector<unsigned char> corrupt(buffer);
+		corrupt[0] ^= 0xff;
+		SX_CHECK_THROWS(sx::serialized_root<root_type>(corrupt.data(), corrupt.size()), std::invalid_argument);
+	}
+}
+
+int main()
+{
+	test_round_trip();
+	test_bad_buffer();
+	return sx_test::report("serialize");
+}
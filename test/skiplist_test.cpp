@@ -0,0 +1,76 @@
+﻿/**************************************************
+ * @brief   : sx_skiplist.h 的行为测试
+ * @file    : skiplist_test.cpp
+ * @author  : 宋旭
+ * @date    : 2026年10月19日，05:14:22
+ **************************************************/
+
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+#include "sx_page_allocator.h"
+#include "sx_skiplist.h"
+#include "sx_test.h"
+
+namespace {
+	void test_basic()
+	{
+		sx::concurrent_skiplist_map<int, std::string> m;
+		SX_CHECK(m.empty());
+		SX_CHECK(m.emplace(2).second);					// 值默认构造
+		SX_CHECK(m.emplace(1, size_t(3), 'x').second);	// 多个参数构造值
+		SX_CHECK(!m.insert({ 1, "y" }).second);			// 已存在的键不覆盖
+		SX_CHECK(m.find(1)->second == "xxx" && m.find(2)->second.empty());
+		SX_CHECK(m.contains(2) && !m.contains(3));
+		SX_CHECK(m.lower_bound(0)->first == 1 && m.upper_bound(1)->first == 2 && m.upper_bound(2) == m.end());
+
+		// 无状态的比较器不占用空间
+		static_assert(sizeof(sx::concurrent_skiplist_map<int, int>) <
+			sizeof(sx::concurrent_skiplist_map<int, int, bool (*)(int, int)>));
+
+		sx::concurrent_skiplist_map<int, int, std::greater<int>> reversed;
+		for (int i = 0; i < 100; ++i) reversed.emplace(i, i);
+		SX_CHECK(reversed.begin()->first == 99);
+	}
+
+	void test_concurrent()
+	{
+		sx::concurrent_skiplist_map<int, int> m(std::less<int>(), 256);
+		const int threads = 4, per_thread = 20000;
+		std::vector<std::thread> workers;
+		for (int t = 0; t < threads; ++t)
+		{
+			workers.emplace_back([&, t] {
+				for (int i = 0; i < per_thread; ++i) m.emplace(i * threads + t, i);
+			});
+		}
+		for (std::thread& w : workers) w.join();
+
+		SX_CHECK(m.size() == size_t(threads * per_thread));
+		int prev = -1, n = 0;
+		bool ordered = true;
+		for (const auto& kv : m)
+		{
+			ordered &= kv.first > prev && kv.second == kv.first / threads;
+			prev = kv.first;
+			++n;
+		}
+		SX_CHECK(ordered && n == threads * per_thread);
+	}
+
+	void test_backend()
+	{
+		sx::concurrent_skiplist_map<int, int, std::less<int>, sx::page_allocator> m;
+		for (int i = 0; i < 10000; ++i) m.emplace(i, i * 2);
+		SX_CHECK(m.size() == 10000 && m.find(777)->second == 1554);
+	}
+}
+
+int main()
+{
+	test_basic();
+	test_concurrent();
+	test_backend();
+	return sx_test::report("skiplist");
+}
@@ -0,0 +1,95 @@
+﻿/**************************************************
+ * @brief   : sx_soa_vector.h 的行为测试
+ * @file    : soa_vector_test.cpp
+ * @author  : 宋旭
+ * @date    : 2026年10月19日，05:18:56
+ **************************************************/
+
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include "sx_soa_vector.h"
+#include "sx_test.h"
+
+namespace {
+	// 第 budget 次复制时抛出异常
+	struct bomb
+	{
+		static inline int budget = 1000000;
+		static inline int live = 0;
+		int value = 0;
+
+		bomb() { ++live; }
+		bomb(int v) : value(v) { ++live; }
+		bomb(const bomb& rhs) : value(rhs.value)
+		{
+			if (--budget < 0) throw std::runtime_error("bomb");
+			++live;
+		}
+		bomb& operator=(const bomb&) = default;
+		~bomb() { --live; }
+	};
+
+	void test_columns()
+	{
+		sx::soa_vector<int, double, std::string> v;
+		for (int i = 0; i < 100; ++i) v.emplace_back(i, i * 0.5, std::to_string(i));
+		SX_CHECK(v.size() == 100);
+		SX_CHECK(std::get<2>(v[42]) == "42" && std::get<1>(v.back()) == 49.5);
+
+		// 每一列是连续的数组
+		auto ints = v.column<0>();
+		SX_CHECK(std::accumulate(ints.begin(), ints.end(), 0) == 4950);
+		SX_CHECK(v.data<1>() + 99 == &std::get<1>(v[99]));
+
+		v.swap_erase(0);
+		SX_CHECK(v.size() == 99 && std::get<0>(v[0]) == 99);
+		v.pop_back();
+		v.resize(10);
+		SX_CHECK(v.size() == 10 && std::get<2>(v[9]) == "9");
+		SX_CHECK_THROWS(v.at(10), std::out_of_range);
+
+		sx::soa_vector<int, double, std::string> copy(v);
+		v.clear();
+		SX_CHECK(v.empty() && copy.size() == 10 && std::get<2>(copy[1]) == "1");
+	}
+
+	void test_aliasing()
+	{
+		// 以容器内的元素为参数追加，扩容时参数仍然有效
+		sx::soa_vector<std::string, int> v;
+		v.emplace_back(std::string(40, 'q'), 0);
+		for (int i = 1; i < 40; ++i) v.emplace_back(std::get<0>(v[0]), i);
+		bool same = true;
+		for (size_t i = 0; i < v.size(); ++i) same &= std::get<0>(v[i]) == std::string(40, 'q');
+		SX_CHECK(same);
+	}
+
+	void test_exception_safety()
+	{
+		using bomb_vector = sx::soa_vector<std::string, bomb>;
+		{
+			bomb_vector v;
+			for (int i = 0; i < 8; ++i) v.emplace_back(std::string(40, char('a' + i)), i);
+
+			// 扩容时复制失败，原有元素保持不变
+			bomb::budget = 3;
+			SX_CHECK_THROWS(v.emplace_back(std::string(40, 'z'), 9), std::runtime_error);
+			bomb::budget = 1000000;
+			SX_CHECK(v.size() == 8 && std::get<0>(v[7]) == std::string(40, 'h') && std::get<1>(v[7]).value == 7);
+
+			bomb::budget = 3;
+			SX_CHECK_THROWS(bomb_vector(v), std::runtime_error);
+			bomb::budget = 1000000;
+		}
+		SX_CHECK(bomb::live == 0);
+	}
+}
+
+int main()
+{
+	test_columns();
+	test_aliasing();
+	test_exception_safety();
+	return sx_test::report("soa_vector");
+}
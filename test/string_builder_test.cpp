@@ -0,0 +1,86 @@
+﻿/**************************************************
+ * @brief   : sx_string_builder.h 的行为测试
+ * @file    : string_builder_test.cpp
+ * @author  : 宋旭
+ * @date    : 2026年10月19日，05:24:10
+ **************************************************/
+
+#include <charconv>
+#include <stdexcept>
+#include <string>
+#include "sx_arena.h"
+#include "sx_string_builder.h"
+#include "sx_test.h"
+
+namespace {
+	void test_string_builder()
+	{
+		sx::string_builder b(64);
+		std::string expect;
+		for (int i = 0; i < 100; ++i)
+		{
+			b += "item ";
+			char* p = b.prepare(16);
+			size_t n = static_cast<size_t>(std::to_chars(p, p + 16, i).ptr - p);
+			b.commit(n);
+			b += ';';
+			expect += "item " + std::to_string(i) + ";";
+		}
+		b.append(200, '-');		// 超过块大小的追加
+		expect.append(200, '-');
+
+		SX_CHECK(b.size() == expect.size() && b.chunk_count() > 1);
+		SX_CHECK(b.str() == expect);
+
+		std::string joined;
+		for (const iovec& v : b.to_iovec()) joined.append(static_cast<const char*>(v.iov_base), v.iov_len);
+		SX_CHECK(joined == expect);
+
+		std::string copied(b.size(), '\0');
+		b.copy_to(copied.data());
+		SX_CHECK(copied == expect);
+
+		sx::string_builder moved(std::move(b));
+		SX_CHECK(moved.str() == expect);
+		moved.clear();
+		SX_CHECK(moved.empty() && moved.str().empty());
+
+		sx::arena a;
+		sx::string_builder from_arena(a, 32);
+		from_arena.append("hello, ").append("arena");
+		SX_CHECK(from_arena.str() == "hello, arena");
+	}
+
+	void test_rope()
+	{
+		sx::rope r("hello world");
+		sx::rope s = r.insert(5, ",");
+		SX_CHECK(s.str() == "hello, world" && r.str() == "hello world");	// 原 rope 不变
+		SX_CHECK(s.erase(0, 7).str() == "world");
+		SX_CHECK(s.substr(7, 3).str() == "wor");
+		SX_CHECK(s[4] == 'o' && s.at(11) == 'd');
+		SX_CHECK_THROWS(s.at(12), std::out_of_range);
+
+		auto parts = s.split(6);
+		SX_CHECK(parts.first.str() == "hello," && parts.second.str() == " world");
+
+		// 大量拼接后树保持平衡
+		sx::rope big;
+		std::string expect;
+		for (int i = 0; i < 2000; ++i)
+		{
+			std::string piece = std::to_string(i) + std::string(40, char('a' + i % 26));
+			big += piece;
+			expect += piece;
+		}
+		SX_CHECK(big.str() == expect && big.length() == expect.size());
+		SX_CHECK(big.depth() < 40);
+	}
+}
+
+int main()
+{
+	test_string_builder();
+	test_rope();
+	return sx_test::report("string_builder");
+}
@@ -0,0 +1,45 @@
+﻿/**************************************************
+ * @brief   : 行为测试使用的检查宏
+ * @file    : sx_test.h
+ * @author  : 宋旭
+ * @date    : 2026年10月19日，04:02:17
+ **************************************************/
+
+#ifndef _SX_TEST_H_
+#define _SX_TEST_H_
+#include <cstdio>			// fprintf, printf
+
+/**
+ * SX_CHECK(expr)						-- expr 为 false 时记录一次失败并继续执行
+ * SX_CHECK_THROWS(expr, exception)	-- expr 必须抛出 exception
+ * main 最后返回 sx_test::report(name)，存在失败时返回 1
+ */
+namespace sx_test {
+	inline int failures = 0;
+
+	inline void fail(const char* expr, const char* file, int line)
+	{
+		std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expr);
+		++failures;
+	}
+
+	inline int report(const char* name)
+	{
+		if (failures == 0) std::printf("%s: ok\n", name);
+		else std::printf("%s: %d check(s) failed\n", name, failures);
+		return failures == 0 ? 0 : 1;
+	}
+}
+
+#define SX_CHECK(expr) ((expr) ? void(0) : sx_test::fail(#expr, __FILE__, __LINE__))
+
+#define SX_CHECK_THROWS(expr, exception)								\
+	do																	\
+	{																	\
+		bool sx_test_thrown = false;									\
+		try { (void)(expr); }											\
+		catch (const exception&) { sx_test_thrown = true; }			\
+		if (!sx_test_thrown) sx_test::fail(#expr " throws " #exception, __FILE__, __LINE__);	\
+	} while (0)
+
+#endif	// end define _SX_TEST_H_
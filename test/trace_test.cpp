@@ -0,0 +1,40 @@
+﻿/**************************************************
+ * @brief   : sx_trace.h 的行为测试，需在开启与关闭 SX_ENABLE_TRACING 时各编译一次
+ * @file    : trace_test.cpp
+ * @author  : 宋旭
+ * @date    : 2026年10月19日，05:27:45
+ **************************************************/
+
+#include <string>
+#include "sx_bitset.h"
+#include "sx_trace.h"
+#include "sx_test.h"
+
+int main()
+{
+	// 同一作用域内可以有多个计时器
+	for (int i = 0; i < 3; ++i)
+	{
+		SX_SCOPED_TIMER("trace_test::outer");
+		SX_SCOPED_TIMER("trace_test::inner");
+	}
+
+	sx::dynamic_bitset b;
+	b.resize(100);
+
+#ifdef SX_ENABLE_TRACING
+	uint64_t outer = 0, inner = 0, resize = 0;
+	for (const auto& [name, snapshot] : sx::trace_report())
+	{
+		if (name == "trace_test::outer") outer = snapshot.count();
+		else if (name == "trace_test::inner") inner = snapshot.count();
+		else if (name == "dynamic_bitset::resize") resize = snapshot.count();
+	}
+	SX_CHECK(outer == 3 && inner == 3);
+	SX_CHECK(resize == 1);
+	return sx_test::report("trace (SX_ENABLE_TRACING)");
+#else
+	SX_CHECK(b.size() == 100);
+	return sx_test::report("trace");
+#endif // SX_ENABLE_TRACING
+}
@@ -0,0 +1,66 @@
+﻿/**************************************************
+ * @brief   : sx_tuple.h 的行为测试
+ * @file    : tuple_test.cpp
+ * @author  : 宋旭
+ * @date    : 2026年10月19日，05:31:18
+ **************************************************/
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include "sx_tuple.h"
+#include "sx_test.h"
+
+namespace {
+	struct empty {};
+
+	// 空类型的元素不占用空间
+	static_assert(sizeof(sx::tuple<int, empty>) == sizeof(int));
+	static_assert(sizeof(sx::tuple<empty, std::less<int>, int>) == sizeof(int));
+	static_assert(std::tuple_size_v<sx::tuple<int, char, double>> == 3);
+	static_assert(std::is_same_v<std::tuple_element_t<1, sx::tuple<int, char, double>>, char>);
+
+	constexpr sx::tuple<int, char> constant(1, 'a');
+	static_assert(sx::get<0>(constant) == 1 && sx::get<char>(constant) == 'a');
+	static_assert(sx::tuple<int, int>(1, 2) < sx::tuple<int, int>(1, 3));
+}
+
+int main()
+{
+	sx::tuple<int, std::string, double> t(1, "one", 1.5);
+	SX_CHECK(sx::get<1>(t) == "one" && sx::get<double>(t) == 1.5);
+	sx::get<0>(t) = 10;
+	SX_CHECK(sx::get<int>(t) == 10);
+
+	auto [i, s, d] = t;
+	SX_CHECK(i == 10 && s == "one" && d == 1.5);
+
+	auto made = sx::make_tuple(2, std::string("two"), 2.5);
+	SX_CHECK(made != t && made == sx::make_tuple(2, std::string("two"), 2.5));
+
+	// tie 赋值，make_tuple 对 reference_wrapper 解包为引用
+	int x = 0;
+	std::string y;
+	sx::tie(x, y) = sx::make_tuple(5, std::string("five"));
+	SX_CHECK(x == 5 && y == "five");
+	auto refs = sx::make_tuple(std::ref(x));
+	sx::get<0>(refs) = 6;
+	SX_CHECK(x == 6);
+
+	auto forwarded = sx::forward_as_tuple(x, std::string("temp"));
+	static_assert(std::is_same_v<decltype(forwarded), sx::tuple<int&, std::string&&>>);
+
+	SX_CHECK(sx::apply([](int a, const std::string& b, double c) { return a + static_cast<int>(b.size()) + static_cast<int>(c); }, t) == 14);
+
+	// 只能移动的元素
+	sx::tuple<std::unique_ptr<int>, int> owner(std::make_unique<int>(7), 0);
+	sx::tuple<std::unique_ptr<int>, int> moved(std::move(owner));
+	SX_CHECK(*sx::get<0>(moved) == 7 && sx::get<0>(owner) == nullptr);
+
+	sx::tuple<int, std::string> a(1, "a"), b(2, "b");
+	a.swap(b);
+	SX_CHECK(sx::get<0>(a) == 2 && sx::get<1>(b) == "a");
+	SX_CHECK(b < a && a >= b);
+	return sx_test::report("tuple");
+}
@@ -0,0 +1,61 @@
+﻿/**************************************************
+ * @brief   : sx_utility.h 的行为测试
+ * @file    : utility_test.cpp
+ * @author  : 宋旭
+ * @date    : 2026年10月19日，05:34:02
+ **************************************************/
+
+#include <functional>
+#include <map>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include "sx_utility.h"
+#include "sx_test.h"
+
+namespace {
+	struct stateless {};
+
+	// 两个成员均可平凡复制时 pair 也可平凡复制
+	static_assert(std::is_trivially_copyable_v<sx::pair<int, double>>);
+	static_assert(sizeof(sx::compressed_pair<stateless, int>) == sizeof(int));
+	static_assert(sizeof(sx::compressed_pair<std::less<int>, std::allocator<int>>) == 1);
+
+	constexpr sx::pair<int, char> constant(1, 'x');
+	static_assert(sx::get<0>(constant) == 1 && constant.second == 'x');
+
+	// 只能以参数列表构造的类型
+	struct point
+	{
+		int x, y;
+		point(int a, int b) : x(a), y(b) {}
+		point(const point&) = delete;
+	};
+}
+
+int main()
+{
+	sx::pair<int, std::string> p(1, "one");
+	sx::pair<int, std::string> q(std::pair<int, const char*>(2, "two"));
+	SX_CHECK(p < q && q > p && p != q && p <= p);
+	swap(p, q);
+	SX_CHECK(p.first == 2 && q.second == "one");
+
+	auto [n, s] = p;
+	SX_CHECK(n == 2 && s == "two");
+
+	// 分段构造，成员原地构造不经过复制
+	sx::pair<point, std::string> pc(sx::piecewise_construct, sx::forward_as_tuple(3, 4), sx::forward_as_tuple(size_t(2), 'z'));
+	SX_CHECK(pc.first.x == 3 && pc.first.y == 4 && pc.second == "zz");
+
+	sx::compressed_pair<std::less<int>, std::string> cp(std::less<int>(), "data");
+	SX_CHECK(cp.first()(1, 2) && cp.second() == "data");
+	sx::compressed_pair<stateless, point> cpp(sx::piecewise_construct, sx::forward_as_tuple(), sx::forward_as_tuple(5, 6));
+	SX_CHECK(cpp.second().y == 6);
+
+	// pair 可以作为有序容器的键
+	std::map<sx::pair<int, int>, int> m;
+	m[sx::pair<int, int>(1, 2)] = 3;
+	SX_CHECK(m.count(sx::pair<int, int>(1, 2)) == 1);
+	return sx_test::report("utility");
+}
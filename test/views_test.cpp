@@ -0,0 +1,91 @@
+﻿/**************************************************
+ * @brief   : sx_views.h 的行为测试
+ * @file    : views_test.cpp
+ * @author  : 宋旭
+ * @date    : 2026年10月19日，05:38:27
+ **************************************************/
+
+#include <iterator>
+#include <list>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "sx_views.h"
+#include "sx_test.h"
+
+namespace {
+	template<class Range>
+	std::vector<int> collect(const Range& r)
+	{
+		std::vector<int> out;
+		for (auto x : r) out.push_back(x);
+		return out;
+	}
+
+	void test_adaptors()
+	{
+		std::vector<int> v{ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+		auto even = [](int x) { return x % 2 == 0; };
+		auto square = [](int x) { return x * x; };
+
+		SX_CHECK((collect(sx::views::filter(v, even)) == std::vector<int>{ 2, 4, 6, 8, 10 }));
+		SX_CHECK((collect(v | sx::views::transform(square) | sx::views::take(3)) == std::vector<int>{ 1, 4, 9 }));
+		SX_CHECK((collect(v | sx::views::filter(even) | sx::views::drop(3)) == std::vector<int>{ 8, 10 }));
+		SX_CHECK(collect(v | sx::views::take(100)).size() == 10);
+		SX_CHECK(collect(v | sx::views::drop(100)).empty());
+		SX_CHECK(collect(v | sx::views::take(0)).empty());
+		SX_CHECK_THROWS(sx::views::take(v, -1), std::invalid_argument);
+		SX_CHECK_THROWS(v | sx::views::drop(-3), std::invalid_argument);
+
+		std::vector<size_t> sizes;
+		for (auto c : sx::views::chunk(v, 4)) sizes.push_back(c.size());
+		SX_CHECK((sizes == std::vector<size_t>{ 4, 4, 2 }));
+		SX_CHECK_THROWS(sx::views::chunk(v, 0), std::invalid_argument);
+	}
+
+	void test_zip_enumerate()
+	{
+		std::vector<int> a{ 1, 2, 3 }, b{ 10, 20, 30, 40, 50 };
+		auto z = sx::views::zip(a, b);
+		SX_CHECK(z.end() - z.begin() == 3);
+
+		// 随机访问时 end 与最短的序列对齐，可以从 end 后退
+		auto last = z.end();
+		--last;
+		auto [x, y] = *last;
+		SX_CHECK(x == 3 && y == 30);
+
+		int sum = 0;
+		for (auto [p, q] : z) sum += p * q;
+		SX_CHECK(sum == 140);
+
+		std::list<int> l{ 1, 2 };
+		auto zl = sx::views::zip(l, a);
+		static_assert(std::is_same_v<std::iterator_traits<decltype(zl.begin())>::iterator_category, sx::forward_iterator_tag>);
+		int n = 0;
+		for (auto t : zl)
+		{
+			(void)t;
+			++n;
+		}
+		SX_CHECK(n == 2);
+
+		std::vector<std::string> words{ "a", "b", "c" };
+		auto e = sx::views::enumerate(words);
+		auto it = e.end();
+		--it;
+		SX_CHECK(std::get<0>(*it) == 2 && std::get<1>(*it) == "c");
+
+		std::string joined;
+		for (auto [i, w] : words | sx::views::enumerate) joined += std::to_string(i) + w;
+		SX_CHECK(joined == "0a1b2c");
+	}
+}
+
+int main()
+{
+	test_adaptors();
+	test_zip_enumerate();
+	return sx_test::report("views");
+}